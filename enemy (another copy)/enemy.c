@@ -5,12 +5,13 @@
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_mixer.h>
 #include "enemy.h"
+#include "assets.h"
 
 // Initialize the background image with a file and set its display properties
 void initialiser_imageBACK(image *image)
 {
     image->url = "background.png"; // Set the file path for the background image
-    image->img = IMG_Load(image->url); // Load the image using SDL_image
+    image->img = acquireOpaqueImage(image->url); // Load the image through the shared asset manager
     if (image->img == NULL) // Check if the image failed to load
     {
         printf("unable to load background image %s \n", SDL_GetError());
@@ -36,12 +37,13 @@ void initEnnemi(Ennemi *e)
     e->pos_depart.x = 260; // Starting x position
     e->pos_depart.y = 100; // Starting y position
     e->pos_actuelle = e->pos_depart; // Current position starts at the starting position
+    e->pos_prec = e->pos_depart;     // No movement yet
     e->direction = 0; // Initial direction (0 = up)
     e->vitesse = 0;   // Speed (not used in movement logic)
     e->alive = 1;     // Enemy starts alive
     e->health = 50;   // Enemy starts with 50 health points
 
-    e->spritesheet = IMG_Load("bat.png"); // Load the sprite sheet for the bat
+    e->spritesheet = acquireImage("bat.png"); // Shared with the other bat: decoded only once
     if (e->spritesheet == NULL) // Check if the sprite sheet failed to load
     {
         printf("Erreur lors du chargement de la spritesheet de l'ennemi : %s\n", SDL_GetError());
@@ -65,12 +67,13 @@ void initEnnemi1(Ennemi *e)
     e->pos_depart.x = 300; // Different starting x position
     e->pos_depart.y = 300; // Different starting y position
     e->pos_actuelle = e->pos_depart;
+    e->pos_prec = e->pos_depart;
     e->direction = 0;
     e->vitesse = 0;
     e->alive = 1;
     e->health = 50;
 
-    e->spritesheet = IMG_Load("bat.png");
+    e->spritesheet = acquireImage("bat.png");
     if (e->spritesheet == NULL)
     {
         printf("Erreur lors du chargement de la spritesheet de l'ennemi : %s\n", SDL_GetError());
@@ -340,3 +343,15 @@ int collisionTri(Ennemi *e, SDL_Rect posPerso) {
     }
     return estcoli;
 }
+
+// Blend the positions of the last two steps so movement looks smooth at
+// any frame rate; teleports (respawns) are drawn at the new position
+SDL_Rect interpolerPosition(SDL_Rect prev, SDL_Rect cur, float alpha)
+{
+    if (abs(cur.x - prev.x) > 64 || abs(cur.y - prev.y) > 64)
+        return cur;
+    SDL_Rect pos = cur;
+    pos.x = prev.x + (int)((cur.x - prev.x) * alpha);
+    pos.y = prev.y + (int)((cur.y - prev.y) * alpha);
+    return pos;
+}
@@ -7,6 +7,12 @@
 #include <SDL/SDL_ttf.h>
 /*---------------------------------------------------*/
 
+// The move functions advance one fixed step: speeds are in pixels per
+// step, and the level runs ENEMY_UPDATE_HZ steps per second whatever the
+// frame rate.
+#define ENEMY_UPDATE_HZ 60
+#define ENEMY_TARGET_FPS 60
+
 // Define possible states for the enemy (bat) behavior
 enum STATE
 {
@@ -21,6 +27,7 @@ typedef struct
 {
   SDL_Rect pos_depart;      // Starting position of the enemy on the screen
   SDL_Rect pos_actuelle;    // Current position of the enemy (used for movement tracking)
+  SDL_Rect pos_prec;        // Position at the previous step (for interpolated drawing)
   int direction;            // Direction of movement (0 = up/left, 1 = down/right)
   float vitesse;            // Speed of the enemy (currently unused in movement)
   SDL_Surface *spritesheet; // Image containing all animation frames for the enemy
@@ -70,5 +77,6 @@ void moveIA(Ennemi *E, SDL_Rect posperso); // Controls the first enemy's AI (sta
 void moveIA1(Ennemi *E, SDL_Rect posperso); // Controls the second enemy's AI (state-based movement)
 int collisuionBB(Ennemi *E, SDL_Rect posPerso); // Checks for collision between enemy and player using bounding box method
 int collisionTri(Ennemi *e, SDL_Rect posPerso); // Checks for collision between enemy and player using circular approximation
+SDL_Rect interpolerPosition(SDL_Rect prev, SDL_Rect cur, float alpha); // Position between two steps for drawing
 
 #endif
@@ -5,22 +5,22 @@
 #include <SDL/SDL_image.h>
 #include <SDL/SDL_mixer.h>
 #include "enemy.h"
+#include "assets.h"
+#include "scene.h"
+#include "spriteatlas.h"
+#include "gradient.h"
+
+// Red when empty, yellow at half, green when full
+static const Uint32 healthStops[] = {0xFF0000FF, 0xFFFF00FF, 0x00FF00FF};
+static Gradient healthGradient;
 
 // Draw a health bar on the screen to represent an entity's health
 void draw_health_bar(SDL_Surface *screen, int health, int max_health, int x, int y, int w, int h) {
+    if (!healthGradient.stopCount) initGradient(&healthGradient, healthStops, 3); // Blended once into a colour table
     SDL_Rect bg_rect = {x, y, w, h}; // Background rectangle for the health bar
-    SDL_FillRect(screen, &bg_rect, SDL_MapRGB(screen->format, 0, 0, 0)); // Fill with black as the background
-    
     float percentage = (health <= 0) ? 0 : (float)health / max_health; // Calculate the health percentage
-    int current_width = (int)(percentage * (w - 2)); // Width of the health bar based on the percentage
-    
-    Uint32 color;
-    if (percentage > 0.5) color = SDL_MapRGB(screen->format, 0, 255, 0); // Green if health > 50%
-    else if (percentage > 0.25) color = SDL_MapRGB(screen->format, 255, 255, 0); // Yellow if health > 25%
-    else color = SDL_MapRGB(screen->format, 255, 0, 0); // Red if health <= 25%
-    
-    SDL_Rect health_rect = {x + 1, y + 1, current_width, h - 2}; // Rectangle for the actual health bar
-    SDL_FillRect(screen, &health_rect, color); // Fill with the appropriate color
+    // Black background, then the health part inset by one pixel in its gradient colour
+    drawProgressBar(screen, &healthGradient, bg_rect, percentage, SDL_MapRGB(screen->format, 0, 0, 0), 1);
 }
 
 // Initialize a coin with a simple appearance (a gold square with a black outline)
@@ -82,201 +82,272 @@ int collisionTriCoin(Coin *coin, SDL_Rect posPerso) {
     return estcoli;
 }
 
-int main(int argc, char *argv[]) {
-    int loop = 1; // Main game loop flag
-    SDL_Surface *screen; // Main screen surface
-    SDL_Event event; // Event handler for user input
+// Everything the enemy level needs between frames
+typedef struct {
     image IMAGE; // Background image
     Ennemi e, e1; // Two enemy bats
     Coin coin1, coin2; // Two collectible coins
-    SDL_Surface *perso = IMG_Load("perso.png"); // Player character image
-    SDL_Rect posPerso = {10, 450}; // Player's starting position
-    int direction = -1; // Player movement direction (-1 = no movement, 0 = left, 1 = right, 2 = down, 3 = up)
-    
-    int health = 100; // Player's health (not used in current logic for player damage)
-    const int max_health = 100; // Maximum health for the player
-    Uint32 last_hit_time = 0; // Timestamp of the last hit (for cooldown)
-    const Uint32 hit_cooldown = 500; // Cooldown between hits (500ms)
-
-    int score = 0; // Player's score
-    int both_coins_collected = 0; // Flag to track if both coins have been collected in the current cycle
+    SDL_Surface *perso; // Player character image
+    SDL_Rect posPerso; // Player's position
+    SDL_Rect prevPerso; // Player's position at the previous step (for interpolated drawing)
+    int direction; // Player movement direction (-1 = no movement, 0 = left, 1 = right, 2 = down, 3 = up)
+    int health; // Player's health (not used in current logic for player damage)
+    int max_health; // Maximum health for the player
+    Uint32 last_hit_time; // Timestamp of the last hit (for cooldown)
+    Uint32 hit_cooldown; // Cooldown between hits (500ms)
+    int score; // Player's score
+    int both_coins_collected; // Flag to track if both coins have been collected in the current cycle
+} EnemyLevel;
 
-    // Initialize SDL for video, audio, and timer
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER) == -1) {
-        printf("SDL init failed: %s\n", SDL_GetError());
-        return -1;
-    }
+static void levelLoad(Scene *self) {
+    EnemyLevel *level = self->data;
+    level->perso = acquireImage("perso.png"); // Loaded after the video mode so it is converted to the display format
+    initialiser_imageBACK(&level->IMAGE); // Initialize the background
+    initEnnemi(&level->e); // Initialize the first enemy
+    initEnnemi1(&level->e1); // Initialize the second enemy
+    initCoin(&level->coin1); // Initialize the first coin
+    initCoin(&level->coin2); // Initialize the second coin
+}
 
-    // Set up the screen with a resolution of 1060x594
-    screen = SDL_SetVideoMode(1060, 594, 32, SDL_SWSURFACE | SDL_DOUBLEBUF | SDL_RESIZABLE);
-    initialiser_imageBACK(&IMAGE); // Initialize the background
-    initEnnemi(&e); // Initialize the first enemy
-    initEnnemi1(&e1); // Initialize the second enemy
-    initCoin(&coin1); // Initialize the first coin
-    initCoin(&coin2); // Initialize the second coin
-
-    Uint32 start; // Start time of each frame (for FPS control)
-    const int FPS = 60; // Target frames per second
-    while (loop) {
-        start = SDL_GetTicks(); // Get the current time for FPS calculation
-        Uint32 current_time = SDL_GetTicks(); // Current time for hit cooldown
-
-        // Handle user input events
-        while (SDL_PollEvent(&event)) {
-            switch (event.type) {
-                case SDL_QUIT: // If the user closes the window, exit the game
-                    loop = 0;
-                    break;
-                case SDL_KEYDOWN: // Handle key presses for movement
-                    switch (event.key.keysym.sym) {
-                        case SDLK_RIGHT: direction = 1; break;
-                        case SDLK_LEFT:  direction = 0; break;
-                        case SDLK_UP:    direction = 3; break;
-                        case SDLK_DOWN:  direction = 2; break;
-                    }
-                    break;
-                case SDL_KEYUP: // Stop movement when keys are released
-                    switch (event.key.keysym.sym) {
-                        case SDLK_RIGHT:
-                        case SDLK_LEFT:
-                        case SDLK_UP:
-                        case SDLK_DOWN:
-                            direction = -1;
-                            break;
-                    }
+static void levelUnload(Scene *self) {
+    EnemyLevel *level = self->data;
+    releaseAsset(level->IMAGE.img);
+    releaseAsset(level->perso);
+    releaseAsset(level->e.spritesheet);
+    releaseAsset(level->e1.spritesheet);
+    SDL_FreeSurface(level->coin1.img);
+    SDL_FreeSurface(level->coin2.img);
+}
+
+static void levelEnter(Scene *self) {
+    EnemyLevel *level = self->data;
+    level->posPerso = (SDL_Rect){10, 450}; // Player's starting position
+    level->prevPerso = level->posPerso;
+    level->direction = -1;
+    level->health = 100;
+    level->max_health = 100;
+    level->last_hit_time = 0;
+    level->hit_cooldown = 500;
+    level->score = 0;
+    level->both_coins_collected = 0;
+}
+
+// Handle user input events
+static void levelHandleEvent(Scene *self, SDL_Event *event) {
+    EnemyLevel *level = self->data;
+    switch (event->type) {
+        case SDL_KEYDOWN: // Handle key presses for movement
+            switch (event->key.keysym.sym) {
+                case SDLK_RIGHT: level->direction = 1; break;
+                case SDLK_LEFT:  level->direction = 0; break;
+                case SDLK_UP:    level->direction = 3; break;
+                case SDLK_DOWN:  level->direction = 2; break;
+            }
+            break;
+        case SDL_KEYUP: // Stop movement when keys are released
+            switch (event->key.keysym.sym) {
+                case SDLK_RIGHT:
+                case SDLK_LEFT:
+                case SDLK_UP:
+                case SDLK_DOWN:
+                    level->direction = -1;
                     break;
             }
+            break;
+    }
+}
+
+static void levelUpdate(Scene *self, Uint32 dtMs) {
+    EnemyLevel *level = self->data;
+    Ennemi *e = &level->e, *e1 = &level->e1;
+    Coin *coin1 = &level->coin1, *coin2 = &level->coin2;
+    SDL_Rect *posPerso = &level->posPerso;
+    Uint32 current_time = SDL_GetTicks(); // Current time for hit cooldown
+
+    // Remember where everything was for interpolated drawing
+    level->prevPerso = *posPerso;
+    e->pos_prec = e->pos_depart;
+    e1->pos_prec = e1->pos_depart;
+
+    // Update the player's position based on the direction
+    if (level->direction == 1) posPerso->x += 5; // Move right
+    if (level->direction == 0) posPerso->x -= 5; // Move left
+    if (level->direction == 3) posPerso->y -= 5; // Move up
+    if (level->direction == 2) posPerso->y += 5; // Move down
+
+    // Keep the player within the screen boundaries
+    if (posPerso->x < 0) posPerso->x = 0;
+    if (posPerso->x > 1060 - level->perso->w) posPerso->x = 1060 - level->perso->w;
+    if (posPerso->y < 0) posPerso->y = 0;
+    if (posPerso->y > 594 - level->perso->h) posPerso->y = 594 - level->perso->h;
+
+    // Animate and move the first enemy if it is alive
+    if (e->alive) {
+        animerEnemi(e);
+        if (level->both_coins_collected) { // If both coins are collected, move horizontally
+            moveHorizontal(e);
+        } else { // Otherwise, use the AI to chase the player
+            moveIA(e, *posPerso);
         }
+    }
 
-        // Update the player's position based on the direction
-        if (direction == 1) posPerso.x += 5; // Move right
-        if (direction == 0) posPerso.x -= 5; // Move left
-        if (direction == 3) posPerso.y -= 5; // Move up
-        if (direction == 2) posPerso.y += 5; // Move down
-
-        // Keep the player within the screen boundaries
-        if (posPerso.x < 0) posPerso.x = 0;
-        if (posPerso.x > 1060 - perso->w) posPerso.x = 1060 - perso->w;
-        if (posPerso.y < 0) posPerso.y = 0;
-        if (posPerso.y > 594 - perso->h) posPerso.y = 594 - perso->h;
-
-        // Draw the background and the player
-        afficher_imageBMP(screen, IMAGE);
-        SDL_BlitSurface(perso, NULL, screen, &posPerso);
-        
-        // Handle the first enemy if it is alive
-        if (e.alive) {
-            afficherEnnemi(e, screen); // Display the enemy
-            animerEnemi(&e); // Animate the enemy
-            if (both_coins_collected) { // If both coins are collected, move horizontally
-                moveHorizontal(&e);
-            } else { // Otherwise, use the AI to chase the player
-                moveIA(&e, posPerso);
-            }
-            draw_health_bar(screen, e.health, 50, e.pos_depart.x, e.pos_depart.y - 15, 40, 10); // Draw the enemy's health bar
+    // Same for the second enemy
+    if (e1->alive) {
+        animerEnemi(e1);
+        if (level->both_coins_collected) {
+            moveHorizontal(e1);
+        } else {
+            moveIA1(e1, *posPerso);
         }
+    }
 
-        // Handle the second enemy if it is alive
-        if (e1.alive) {
-            afficherEnnemi(e1, screen);
-            animerEnemi(&e1);
-            if (both_coins_collected) {
-                moveHorizontal(&e1);
-            } else {
-                moveIA1(&e1, posPerso);
+    // Check for collisions between the player and the enemies
+    if (collisionTri(e, *posPerso) || collisuionBB(e1, *posPerso)) {
+        if (current_time - level->last_hit_time >= level->hit_cooldown) { // Only apply damage if the cooldown has passed
+            int e_was_alive = e->alive; // Track if the enemy was alive before taking damage
+            e->health -= 10; // Reduce the first enemy's health
+            if (e->health <= 0 && e_was_alive) { // If the enemy is defeated
+                e->alive = 0; // Mark the enemy as defeated
+                level->score += 100; // Add points to the score
+                printf("Bat defeated! Score: %d\n", level->score);
+                coin1->pos.x = e->pos_depart.x; // Drop a coin at the enemy's position
+                coin1->pos.y = e->pos_depart.y;
+                coin1->visible = 1; // Make the coin visible
+                printf("Coin 1 dropped at (%d, %d)\n", coin1->pos.x, coin1->pos.y);
             }
-            draw_health_bar(screen, e1.health, 50, e1.pos_depart.x, e1.pos_depart.y - 15, 40, 10);
-        }
 
-        // Check for collisions between the player and the enemies
-        if (collisionTri(&e, posPerso) || collisuionBB(&e1, posPerso)) {
-            if (current_time - last_hit_time >= hit_cooldown) { // Only apply damage if the cooldown has passed
-                int e_was_alive = e.alive; // Track if the enemy was alive before taking damage
-                e.health -= 10; // Reduce the first enemy's health
-                if (e.health <= 0 && e_was_alive) { // If the enemy is defeated
-                    e.alive = 0; // Mark the enemy as defeated
-                    score += 100; // Add points to the score
-                    printf("Bat defeated! Score: %d\n", score);
-                    coin1.pos.x = e.pos_depart.x; // Drop a coin at the enemy's position
-                    coin1.pos.y = e.pos_depart.y;
-                    coin1.visible = 1; // Make the coin visible
-                    printf("Coin 1 dropped at (%d, %d)\n", coin1.pos.x, coin1.pos.y);
-                }
-
-                int e1_was_alive = e1.alive;
-                e1.health -= 10; // Reduce the second enemy's health
-                if (e1.health <= 0 && e1_was_alive) {
-                    e1.alive = 0;
-                    score += 100;
-                    printf("Bat defeated! Score: %d\n", score);
-                    coin2.pos.x = e1.pos_depart.x;
-                    coin2.pos.y = e1.pos_depart.y;
-                    coin2.visible = 1;
-                    printf("Coin 2 dropped at (%d, %d)\n", coin2.pos.x, coin2.pos.y);
-                }
-
-                last_hit_time = current_time; // Update the last hit time
+            int e1_was_alive = e1->alive;
+            e1->health -= 10; // Reduce the second enemy's health
+            if (e1->health <= 0 && e1_was_alive) {
+                e1->alive = 0;
+                level->score += 100;
+                printf("Bat defeated! Score: %d\n", level->score);
+                coin2->pos.x = e1->pos_depart.x;
+                coin2->pos.y = e1->pos_depart.y;
+                coin2->visible = 1;
+                printf("Coin 2 dropped at (%d, %d)\n", coin2->pos.x, coin2->pos.y);
             }
-        }
 
-        // Check if the player collects the first coin
-        if (coin1.visible && collisionTriCoin(&coin1, posPerso)) {
-            coin1.visible = 0; // Hide the coin
-            score += 50; // Add points to the score
-            printf("Coin 1 collected! Score: %d\n", score);
+            level->last_hit_time = current_time; // Update the last hit time
         }
+    }
 
-        // Check if the player collects the second coin
-        if (coin2.visible && collisionTriCoin(&coin2, posPerso)) {
-            coin2.visible = 0;
-            score += 50;
-            printf("Coin 2 collected! Score: %d\n", score);
-        }
+    // Check if the player collects the first coin
+    if (coin1->visible && collisionTriCoin(coin1, *posPerso)) {
+        coin1->visible = 0; // Hide the coin
+        level->score += 50; // Add points to the score
+        printf("Coin 1 collected! Score: %d\n", level->score);
+    }
 
-        // If both coins are collected and both enemies are defeated, respawn the enemies
-        if (!coin1.visible && !coin2.visible && !e.alive && !e1.alive && !both_coins_collected) {
-            // Respawn the first enemy at the bottom-left corner
-            e.pos_depart.x = 12;
-            e.pos_depart.y = 594 - e.pos_sprites.h;
-            e.health = 50;
-            e.alive = 1;
-            e.state = WAITING;
-            printf("Bat e respawned at bottom-left corner (%d, %d)\n", e.pos_depart.x, e.pos_depart.y);
-
-            // Respawn the second enemy at the bottom-right corner
-            e1.pos_depart.x = 1060 - e1.pos_sprites.w;
-            e1.pos_depart.y = 594 - e1.pos_sprites.h;
-            e1.health = 50;
-            e1.alive = 1;
-            e1.state = WAITING;
-            printf("Bat e1 respawned at bottom-right corner (%d, %d)\n", e1.pos_depart.x, e1.pos_depart.y);
-
-            both_coins_collected = 1; // Mark that both coins have been collected
-        }
+    // Check if the player collects the second coin
+    if (coin2->visible && collisionTriCoin(coin2, *posPerso)) {
+        coin2->visible = 0;
+        level->score += 50;
+        printf("Coin 2 collected! Score: %d\n", level->score);
+    }
 
-        // Reset the flag when both enemies are defeated again, allowing a new cycle
-        if (!e.alive && !e1.alive && both_coins_collected) {
-            both_coins_collected = 0;
-        }
+    // If both coins are collected and both enemies are defeated, respawn the enemies
+    if (!coin1->visible && !coin2->visible && !e->alive && !e1->alive && !level->both_coins_collected) {
+        // Respawn the first enemy at the bottom-left corner
+        e->pos_depart.x = 12;
+        e->pos_depart.y = 594 - e->pos_sprites.h;
+        e->health = 50;
+        e->alive = 1;
+        e->state = WAITING;
+        printf("Bat e respawned at bottom-left corner (%d, %d)\n", e->pos_depart.x, e->pos_depart.y);
+
+        // Respawn the second enemy at the bottom-right corner
+        e1->pos_depart.x = 1060 - e1->pos_sprites.w;
+        e1->pos_depart.y = 594 - e1->pos_sprites.h;
+        e1->health = 50;
+        e1->alive = 1;
+        e1->state = WAITING;
+        printf("Bat e1 respawned at bottom-right corner (%d, %d)\n", e1->pos_depart.x, e1->pos_depart.y);
+
+        level->both_coins_collected = 1; // Mark that both coins have been collected
+    }
 
-        // Display the coins on the screen
-        displayCoin(&coin1, screen);
-        displayCoin(&coin2, screen);
+    // Reset the flag when both enemies are defeated again, allowing a new cycle
+    if (!e->alive && !e1->alive && level->both_coins_collected) {
+        level->both_coins_collected = 0;
+    }
+
+    // Everything moves every step, so the whole screen is redrawn.
+    markAllDirty(&self->stack->compositor);
+}
+
+static void levelRender(Scene *self, SDL_Surface *screen) {
+    EnemyLevel *level = self->data;
+    float alpha = getSceneAlpha(self->stack); // Fraction of a step since the last update
 
-        // Draw the player's health bar (though player health isn't modified in this code)
-        draw_health_bar(screen, health, max_health, 840, 20, 200, 20);
+    // Draw the background and the player
+    afficher_imageBMP(screen, level->IMAGE);
+    SDL_Rect posPerso = interpolerPosition(level->prevPerso, level->posPerso, alpha);
+    SDL_BlitSurface(level->perso, NULL, screen, &posPerso);
 
-        SDL_Flip(screen); // Update the screen to show the new frame
-        // Control the frame rate to maintain 60 FPS
-        if (1000/FPS > SDL_GetTicks() - start)
-            SDL_Delay(1000/FPS - (SDL_GetTicks() - start));
+    // Draw the enemies that are alive, with their health bars
+    if (level->e.alive) {
+        Ennemi e = level->e;
+        e.pos_depart = interpolerPosition(e.pos_prec, e.pos_depart, alpha);
+        afficherEnnemi(e, screen);
+        draw_health_bar(screen, e.health, 50, e.pos_depart.x, e.pos_depart.y - 15, 40, 10);
     }
+    if (level->e1.alive) {
+        Ennemi e1 = level->e1;
+        e1.pos_depart = interpolerPosition(e1.pos_prec, e1.pos_depart, alpha);
+        afficherEnnemi(e1, screen);
+        draw_health_bar(screen, e1.health, 50, e1.pos_depart.x, e1.pos_depart.y - 15, 40, 10);
+    }
+
+    // Display the coins on the screen
+    displayCoin(&level->coin1, screen);
+    displayCoin(&level->coin2, screen);
+
+    // Draw the player's health bar (though player health isn't modified in this code)
+    draw_health_bar(screen, level->health, level->max_health, 840, 20, 200, 20);
+}
+
+int main(int argc, char *argv[]) {
+    SDL_Surface *screen; // Main screen surface
+    EnemyLevel level;
+    Scene levelScene = {0};
+    SceneStack scenes;
+    SpriteAtlas sprites;
+
+    // Initialize SDL for video, audio, and timer
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER) == -1) {
+        printf("SDL init failed: %s\n", SDL_GetError());
+        return -1;
+    }
+
+    // Set up the screen with a resolution of 1060x594
+    screen = SDL_SetVideoMode(1060, 594, 32, SDL_SWSURFACE | SDL_DOUBLEBUF | SDL_RESIZABLE);
+
+    // Player and bat sheets from one packed file ("make sprites.atlas"), when built
+    if (loadSpriteAtlas(&sprites, SPRITE_ATLAS_FILE))
+        adoptAtlasSprites(&sprites);
+
+    // The level runs as a scene on the same loop as the quiz and puzzle
+    levelScene.name = "enemy";
+    levelScene.data = &level;
+    levelScene.load = levelLoad;
+    levelScene.unload = levelUnload;
+    levelScene.enter = levelEnter;
+    levelScene.handleEvent = levelHandleEvent;
+    levelScene.update = levelUpdate;
+    levelScene.render = levelRender;
+
+    initSceneStack(&scenes, screen);
+    initFrameLoop(&scenes.loop, ENEMY_UPDATE_HZ, ENEMY_TARGET_FPS);
+    pushScene(&scenes, &levelScene);
+    runScenes(&scenes);
 
     // Clean up resources before exiting
-    SDL_FreeSurface(IMAGE.img);
-    SDL_FreeSurface(perso);
-    SDL_FreeSurface(coin1.img);
-    SDL_FreeSurface(coin2.img);
+    printSceneProfile(&scenes);
+    freeSceneStack(&scenes);
+    printAssetReport(); // Resident memory per asset
+    purgeUnusedAssets();
+    freeSpriteAtlas(&sprites);
     SDL_Quit();
     return 0;
 }
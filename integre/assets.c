@@ -0,0 +1,238 @@
+#include "assets.h"
+#include "pak.h"
+#include "baked.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Converts a surface to the display format and frees the original.
+// Surfaces with per-pixel alpha keep it; RLE speeds up blits of images
+// with large transparent areas (buttons, sprites).
+SDL_Surface* optimizeSurface(SDL_Surface *surface, int useRle) {
+    if (!surface)
+        return NULL;
+
+    SDL_Surface *converted = surface->format->Amask ? SDL_DisplayFormatAlpha(surface)
+                                                    : SDL_DisplayFormat(surface);
+    if (!converted)
+        return surface;
+    SDL_FreeSurface(surface);
+
+    if (useRle && converted->format->Amask)
+        SDL_SetAlpha(converted, SDL_SRCALPHA | SDL_RLEACCEL, SDL_ALPHA_OPAQUE);
+    return converted;
+}
+
+SDL_Surface* loadImage(const char *path) {
+    SDL_Surface *surface = IMG_Load_RW(openAssetRW(path), 1);
+    if (!surface) {
+        fprintf(stderr, "Erreur lors du chargement de %s : %s\n", path, IMG_GetError());
+        return NULL;
+    }
+    return optimizeSurface(surface, 1);
+}
+
+static int isDisplayFormat(SDL_Surface *surface) {
+    SDL_Surface *screen = SDL_GetVideoSurface();
+    if (!screen)
+        return 0;
+    SDL_PixelFormat *a = surface->format, *b = screen->format;
+    return a->BitsPerPixel == b->BitsPerPixel && a->Rmask == b->Rmask && a->Gmask == b->Gmask &&
+           a->Bmask == b->Bmask && a->Amask == 0 && b->Amask == 0;
+}
+
+// Drops the alpha channel: for opaque images (JPEG tiles, backdrops) an
+// alpha-blended blit is several times slower than a plain copy. Full-screen
+// backdrops also need this for fades, since SDL ignores the per-surface
+// alpha of surfaces that carry per-pixel alpha.
+SDL_Surface* optimizeOpaqueSurface(SDL_Surface *surface) {
+    if (!surface)
+        return NULL;
+    if (isDisplayFormat(surface))
+        return surface;   // Baked images are already converted
+
+    SDL_Surface *converted = SDL_DisplayFormat(surface);
+    if (!converted)
+        return surface;
+    SDL_FreeSurface(surface);
+    return converted;
+}
+
+SDL_Surface* loadOpaqueImage(const char *path) {
+    SDL_Surface *surface = loadBakedImage(path, 0, 0);
+    if (surface)
+        return surface;
+    surface = IMG_Load_RW(openAssetRW(path), 1);
+    if (!surface) {
+        fprintf(stderr, "Erreur lors du chargement de %s : %s\n", path, IMG_GetError());
+        return NULL;
+    }
+    return optimizeOpaqueSurface(surface);
+}
+
+static Asset *assets = NULL;
+static int assetCount = 0;
+static int assetCapacity = 0;
+
+static size_t fileSize(const char *path) {
+    long size = assetSize(path);
+    return size > 0 ? (size_t)size : 0;
+}
+
+static Asset* findAsset(AssetType type, const char *path, int size) {
+    for (int i = 0; i < assetCount; i++) {
+        if (assets[i].type == type && assets[i].size == size && strcmp(assets[i].path, path) == 0)
+            return &assets[i];
+    }
+    return NULL;
+}
+
+static void* registerAsset(AssetType type, const char *path, int size, void *data, size_t bytes, int refCount) {
+    if (!data)
+        return NULL;
+    if (assetCount == assetCapacity) {
+        int capacity = assetCapacity ? assetCapacity * 2 : 32;
+        Asset *grown = realloc(assets, capacity * sizeof(Asset));
+        if (!grown)
+            return data;   // Still usable, just not shared
+        assets = grown;
+        assetCapacity = capacity;
+    }
+    Asset *a = &assets[assetCount++];
+    a->path = strdup(path);
+    a->size = size;
+    a->type = type;
+    a->data = data;
+    a->refCount = refCount;
+    a->bytes = bytes;
+    return data;
+}
+
+static void freeAssetData(Asset *a) {
+    switch (a->type) {
+    case ASSET_IMAGE:
+    case ASSET_OPAQUE_IMAGE:
+        SDL_FreeSurface(a->data);
+        break;
+    case ASSET_FONT:
+        TTF_CloseFont(a->data);
+        break;
+    case ASSET_SOUND:
+        Mix_FreeChunk(a->data);
+        break;
+    }
+    free(a->path);
+}
+
+// Surfaces over pixels owned elsewhere (atlas sprites) cost nothing extra.
+static size_t surfaceBytes(SDL_Surface *surface) {
+    if (!surface || (surface->flags & SDL_PREALLOC))
+        return 0;
+    return (size_t)surface->pitch * surface->h;
+}
+
+SDL_Surface* acquireImage(const char *path) {
+    Asset *a = findAsset(ASSET_IMAGE, path, 0);
+    if (a) {
+        a->refCount++;
+        return a->data;
+    }
+    SDL_Surface *surface = loadImage(path);
+    return registerAsset(ASSET_IMAGE, path, 0, surface, surfaceBytes(surface), 1);
+}
+
+SDL_Surface* acquireOpaqueImage(const char *path) {
+    Asset *a = findAsset(ASSET_OPAQUE_IMAGE, path, 0);
+    if (a) {
+        a->refCount++;
+        return a->data;
+    }
+    SDL_Surface *surface = loadOpaqueImage(path);
+    return registerAsset(ASSET_OPAQUE_IMAGE, path, 0, surface, surfaceBytes(surface), 1);
+}
+
+TTF_Font* acquireFont(const char *path, int size) {
+    Asset *a = findAsset(ASSET_FONT, path, size);
+    if (a) {
+        a->refCount++;
+        return a->data;
+    }
+    TTF_Font *font = TTF_OpenFontRW(openAssetRW(path), 1, size);
+    if (!font)
+        fprintf(stderr, "Erreur lors du chargement de %s : %s\n", path, TTF_GetError());
+    // FreeType keeps the face and glyph cache; the file size is a fair estimate.
+    return registerAsset(ASSET_FONT, path, size, font, fileSize(path), 1);
+}
+
+Mix_Chunk* acquireSound(const char *path) {
+    Asset *a = findAsset(ASSET_SOUND, path, 0);
+    if (a) {
+        a->refCount++;
+        return a->data;
+    }
+    Mix_Chunk *chunk = Mix_LoadWAV_RW(openAssetRW(path), 1);
+    if (!chunk)
+        fprintf(stderr, "Erreur lors du chargement de %s : %s\n", path, Mix_GetError());
+    return registerAsset(ASSET_SOUND, path, 0, chunk, chunk ? chunk->alen : 0, 1);
+}
+
+void adoptAsset(AssetType type, const char *path, void *data) {
+    if (!data)
+        return;
+    if (findAsset(type, path, 0)) {
+        // Someone loaded it synchronously meanwhile: keep the first copy.
+        if (type == ASSET_SOUND)
+            Mix_FreeChunk(data);
+        else
+            SDL_FreeSurface(data);
+        return;
+    }
+    size_t bytes = (type == ASSET_SOUND) ? ((Mix_Chunk *)data)->alen : surfaceBytes(data);
+    registerAsset(type, path, 0, data, bytes, 0);
+}
+
+void releaseAsset(void *data) {
+    if (!data)
+        return;
+    for (int i = 0; i < assetCount; i++) {
+        if (assets[i].data == data) {
+            if (assets[i].refCount > 0)
+                assets[i].refCount--;
+            return;
+        }
+    }
+    fprintf(stderr, "releaseAsset: unknown asset %p\n", data);
+}
+
+void purgeUnusedAssets(void) {
+    int kept = 0;
+    for (int i = 0; i < assetCount; i++) {
+        if (assets[i].refCount == 0)
+            freeAssetData(&assets[i]);
+        else
+            assets[kept++] = assets[i];
+    }
+    assetCount = kept;
+    if (assetCount == 0) {
+        free(assets);
+        assets = NULL;
+        assetCapacity = 0;
+    }
+}
+
+void printAssetReport(void) {
+    static const char *typeNames[] = {"image", "image", "font", "sound"};
+    size_t total = 0;
+    printf("%-28s %-6s %5s %10s\n", "asset", "type", "refs", "bytes");
+    for (int i = 0; i < assetCount; i++) {
+        char name[64];
+        if (assets[i].type == ASSET_FONT)
+            snprintf(name, sizeof(name), "%s@%d", assets[i].path, assets[i].size);
+        else
+            snprintf(name, sizeof(name), "%s", assets[i].path);
+        printf("%-28s %-6s %5d %10lu\n", name, typeNames[assets[i].type],
+               assets[i].refCount, (unsigned long)assets[i].bytes);
+        total += assets[i].bytes;
+    }
+    printf("%d assets, %lu bytes resident\n", assetCount, (unsigned long)total);
+}
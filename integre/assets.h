@@ -0,0 +1,47 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_image.h>
+#include <SDL/SDL_mixer.h>
+#include <SDL/SDL_ttf.h>
+#include <stddef.h>
+
+// All loaders require the video mode to be set, since they convert to the
+// display pixel format. On conversion failure the decoded surface is returned.
+SDL_Surface* optimizeSurface(SDL_Surface *surface, int useRle);
+SDL_Surface* optimizeOpaqueSurface(SDL_Surface *surface);
+SDL_Surface* loadImage(const char *path);
+SDL_Surface* loadOpaqueImage(const char *path);
+
+typedef enum {
+    ASSET_IMAGE,
+    ASSET_OPAQUE_IMAGE,
+    ASSET_FONT,
+    ASSET_SOUND
+} AssetType;
+
+typedef struct {
+    char *path;
+    int size;              // Point size for fonts, 0 otherwise
+    AssetType type;
+    void *data;
+    int refCount;          // Assets at 0 stay resident until purgeUnusedAssets()
+    size_t bytes;          // Approximate resident memory
+} Asset;
+
+// Shared, path-keyed assets: each file is decoded once per process.
+// Every acquire must be balanced by releaseAsset(); never free the
+// returned pointers directly.
+SDL_Surface* acquireImage(const char *path);
+SDL_Surface* acquireOpaqueImage(const char *path);
+TTF_Font* acquireFont(const char *path, int size);
+Mix_Chunk* acquireSound(const char *path);
+// Registers an image or sound decoded elsewhere (e.g. by the preloader)
+// with no references yet, so the next acquire of that path finds it.
+void adoptAsset(AssetType type, const char *path, void *data);
+void releaseAsset(void *data);
+void purgeUnusedAssets(void);
+void printAssetReport(void);
+
+#endif // ASSETS_H
@@ -0,0 +1,153 @@
+#include "baked.h"
+#include "pak.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+static void bakedName(const char *path, char *name, size_t size) {
+    snprintf(name, size, "%s%s", path, BAKED_SUFFIX);
+}
+
+static int checkHeader(const BakedHeader *hdr, int w, int h) {
+    SDL_Surface *screen = SDL_GetVideoSurface();
+    if (!screen || hdr->magic != BAKED_MAGIC || hdr->version != BAKED_VERSION)
+        return 0;
+    // Stale bake (the requested size changed) or another display format:
+    // decoding the original is then no slower than fixing this one up.
+    if ((w && hdr->w != (Uint32)w) || (h && hdr->h != (Uint32)h) || hdr->w == 0 || hdr->h == 0)
+        return 0;
+    SDL_PixelFormat *fmt = screen->format;
+    if (hdr->bpp != fmt->BitsPerPixel || hdr->rmask != fmt->Rmask || hdr->gmask != fmt->Gmask ||
+        hdr->bmask != fmt->Bmask || hdr->amask != fmt->Amask)
+        return 0;
+    if (hdr->pitch < hdr->w * fmt->BytesPerPixel || hdr->pitch % 4 != 0)
+        return 0;
+    if (hdr->compression == BAKED_RAW)
+        return hdr->dataSize == hdr->pitch * hdr->h;
+#ifdef HAVE_LZ4
+    return hdr->compression == BAKED_LZ4;
+#else
+    return 0;
+#endif
+}
+
+// SDL pads rows to 4 bytes, as the bake tool did: the pixels go in with
+// one copy (or one decompression) instead of row by row.
+static SDL_Surface* createSurface(const BakedHeader *hdr) {
+    SDL_Surface *surface = SDL_CreateRGBSurface(SDL_SWSURFACE, hdr->w, hdr->h, hdr->bpp,
+                                                hdr->rmask, hdr->gmask, hdr->bmask, hdr->amask);
+    if (surface && (Uint32)surface->pitch != hdr->pitch) {
+        SDL_FreeSurface(surface);
+        return NULL;
+    }
+    return surface;
+}
+
+static int unpack(const BakedHeader *hdr, const void *data, SDL_Surface *surface) {
+    size_t bytes = (size_t)hdr->pitch * hdr->h;
+    if (hdr->compression == BAKED_RAW) {
+        memcpy(surface->pixels, data, bytes);
+        return 1;
+    }
+#ifdef HAVE_LZ4
+    return LZ4_decompress_safe(data, surface->pixels, hdr->dataSize, bytes) == (int)bytes;
+#else
+    return 0;
+#endif
+}
+
+static SDL_Surface* loadPacked(const Uint8 *packed, Uint32 size, int w, int h) {
+    const BakedHeader *hdr = (const BakedHeader *)packed;
+    if (size < sizeof(BakedHeader) || !checkHeader(hdr, w, h) || size - sizeof(BakedHeader) < hdr->dataSize)
+        return NULL;
+    const Uint8 *data = packed + sizeof(BakedHeader);
+    if (hdr->compression == BAKED_RAW)
+        return SDL_CreateRGBSurfaceFrom((void *)data, hdr->w, hdr->h, hdr->bpp, hdr->pitch,
+                                        hdr->rmask, hdr->gmask, hdr->bmask, hdr->amask);
+    SDL_Surface *surface = createSurface(hdr);
+    if (surface && !unpack(hdr, data, surface)) {
+        SDL_FreeSurface(surface);
+        surface = NULL;
+    }
+    return surface;
+}
+
+SDL_Surface* loadBakedImage(const char *path, int w, int h) {
+    char name[256];
+    bakedName(path, name, sizeof(name));
+
+    Uint32 size;
+    const void *packed = findPakFile(name, &size);
+    if (packed)
+        return loadPacked(packed, size, w, h);
+
+    FILE *fp = fopen(name, "rb");
+    if (!fp)
+        return NULL;
+    BakedHeader hdr;
+    SDL_Surface *surface = NULL;
+    if (fread(&hdr, sizeof(hdr), 1, fp) == 1 && checkHeader(&hdr, w, h))
+        surface = createSurface(&hdr);
+    if (surface) {
+        int ok;
+        if (hdr.compression == BAKED_RAW) {
+            ok = fread(surface->pixels, 1, hdr.dataSize, fp) == hdr.dataSize;
+        } else {
+            void *data = malloc(hdr.dataSize);
+            ok = data && fread(data, 1, hdr.dataSize, fp) == hdr.dataSize && unpack(&hdr, data, surface);
+            free(data);
+        }
+        if (!ok) {
+            fprintf(stderr, "Erreur : %s tronque\n", name);
+            SDL_FreeSurface(surface);
+            surface = NULL;
+        }
+    }
+    fclose(fp);
+    return surface;
+}
+
+int writeBakedImage(const char *path, SDL_Surface *surface, int compress) {
+    char name[256];
+    bakedName(path, name, sizeof(name));
+
+    SDL_PixelFormat *fmt = surface->format;
+    BakedHeader hdr = {BAKED_MAGIC, BAKED_VERSION, surface->w, surface->h, fmt->BitsPerPixel,
+                       surface->pitch, fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask,
+                       BAKED_RAW, (Uint32)surface->pitch * surface->h};
+
+    SDL_LockSurface(surface);
+    const void *data = surface->pixels;
+    void *compressed = NULL;
+#ifdef HAVE_LZ4
+    if (compress) {
+        int bound = LZ4_compressBound(hdr.dataSize);
+        compressed = malloc(bound);
+        int packedSize = compressed ? LZ4_compress_default(data, compressed, hdr.dataSize, bound) : 0;
+        // Keep it raw when compression does not pay off.
+        if (packedSize > 0 && (Uint32)packedSize < hdr.dataSize) {
+            data = compressed;
+            hdr.compression = BAKED_LZ4;
+            hdr.dataSize = packedSize;
+        }
+    }
+#else
+    (void)compress;
+#endif
+
+    FILE *fp = fopen(name, "wb");
+    int ok = fp && fwrite(&hdr, sizeof(hdr), 1, fp) == 1 &&
+             fwrite(data, 1, hdr.dataSize, fp) == hdr.dataSize;
+    if (fp && fclose(fp) != 0)
+        ok = 0;
+    SDL_UnlockSurface(surface);
+    free(compressed);
+    if (!ok) {
+        fprintf(stderr, "Erreur : impossible d'ecrire %s\n", name);
+        remove(name);
+    }
+    return ok;
+}
@@ -0,0 +1,36 @@
+#ifndef BAKED_H
+#define BAKED_H
+
+#include <SDL/SDL.h>
+
+#define BAKED_MAGIC 0x454B4142  // "BAKE"
+#define BAKED_VERSION 1
+#define BAKED_SUFFIX ".bake"    // bg.jpeg is baked to bg.jpeg.bake
+
+enum {
+    BAKED_RAW,
+    BAKED_LZ4                   // Needs a build with -DHAVE_LZ4 -llz4
+};
+
+// Written by tools/bake_images.c: an image already scaled and converted to
+// the display pixel format, so loading it is a copy instead of a decode.
+// The pixels follow the header, rows padded to `pitch` like SDL surfaces.
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 w, h;
+    Uint32 bpp, pitch;
+    Uint32 rmask, gmask, bmask, amask;
+    Uint32 compression;
+    Uint32 dataSize;            // Bytes after the header
+} BakedHeader;
+
+// Loads the baked version of `path` if there is one of size w x h (0 for
+// any size) in the display format; NULL otherwise, and the caller decodes
+// the original. Uncompressed images in the asset archive are not copied
+// at all: the surface points into the mapping and must be freed before
+// closePak().
+SDL_Surface* loadBakedImage(const char *path, int w, int h);
+int writeBakedImage(const char *path, SDL_Surface *surface, int compress);
+
+#endif // BAKED_H
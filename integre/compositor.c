@@ -0,0 +1,82 @@
+#include "compositor.h"
+
+static int overlaps(const SDL_Rect *a, const SDL_Rect *b) {
+    return a->x < b->x + b->w && b->x < a->x + a->w &&
+           a->y < b->y + b->h && b->y < a->y + a->h;
+}
+
+static SDL_Rect unionRect(const SDL_Rect *a, const SDL_Rect *b) {
+    int x1 = a->x < b->x ? a->x : b->x;
+    int y1 = a->y < b->y ? a->y : b->y;
+    int x2 = (a->x + a->w > b->x + b->w) ? a->x + a->w : b->x + b->w;
+    int y2 = (a->y + a->h > b->y + b->h) ? a->y + a->h : b->y + b->h;
+    SDL_Rect r = {x1, y1, x2 - x1, y2 - y1};
+    return r;
+}
+
+void initCompositor(Compositor *comp, SDL_Surface *screen) {
+    comp->screen = screen;
+    comp->count = 0;
+    comp->fullRedraw = 1;
+    comp->framesPresented = 0;
+    comp->framesSkipped = 0;
+}
+
+void markDirty(Compositor *comp, SDL_Rect rect) {
+    if (comp->fullRedraw)
+        return;
+
+    // Clip to the screen.
+    int x1 = rect.x < 0 ? 0 : rect.x;
+    int y1 = rect.y < 0 ? 0 : rect.y;
+    int x2 = rect.x + rect.w > comp->screen->w ? comp->screen->w : rect.x + rect.w;
+    int y2 = rect.y + rect.h > comp->screen->h ? comp->screen->h : rect.y + rect.h;
+    if (x2 <= x1 || y2 <= y1)
+        return;
+    SDL_Rect r = {x1, y1, x2 - x1, y2 - y1};
+
+    // Merge with any region it touches so the list stays disjoint.
+    int i = 0;
+    while (i < comp->count) {
+        if (overlaps(&r, &comp->dirty[i])) {
+            r = unionRect(&r, &comp->dirty[i]);
+            comp->dirty[i] = comp->dirty[--comp->count];
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    if (comp->count == MAX_DIRTY_RECTS)
+        markAllDirty(comp);
+    else
+        comp->dirty[comp->count++] = r;
+}
+
+void markAllDirty(Compositor *comp) {
+    comp->fullRedraw = 1;
+    comp->count = 0;
+}
+
+int getDirtyCount(const Compositor *comp) {
+    return comp->fullRedraw ? 1 : comp->count;
+}
+
+void clipToDirty(Compositor *comp, int index) {
+    SDL_SetClipRect(comp->screen, comp->fullRedraw ? NULL : &comp->dirty[index]);
+}
+
+void presentDirty(Compositor *comp) {
+    SDL_SetClipRect(comp->screen, NULL);
+    if (comp->fullRedraw) {
+        SDL_Flip(comp->screen);
+        comp->framesPresented++;
+    } else if (comp->count > 0) {
+        SDL_UpdateRects(comp->screen, comp->count, comp->dirty);
+        comp->framesPresented++;
+    } else {
+        comp->framesSkipped++;
+    }
+    comp->fullRedraw = 0;
+    comp->count = 0;
+}
@@ -0,0 +1,24 @@
+#ifndef COMPOSITOR_H
+#define COMPOSITOR_H
+
+#include <SDL/SDL.h>
+
+#define MAX_DIRTY_RECTS 32
+
+typedef struct {
+    SDL_Surface *screen;
+    SDL_Rect dirty[MAX_DIRTY_RECTS];  // Disjoint regions to redraw this frame
+    int count;
+    int fullRedraw;                   // Set when the whole screen must be redrawn
+    unsigned long framesPresented;
+    unsigned long framesSkipped;      // Idle frames where nothing changed
+} Compositor;
+
+void initCompositor(Compositor *comp, SDL_Surface *screen);
+void markDirty(Compositor *comp, SDL_Rect rect);
+void markAllDirty(Compositor *comp);
+int getDirtyCount(const Compositor *comp);
+void clipToDirty(Compositor *comp, int index);
+void presentDirty(Compositor *comp);
+
+#endif // COMPOSITOR_H
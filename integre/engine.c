@@ -0,0 +1,129 @@
+#include "engine.h"
+#include "assets.h"
+#include "tilecache.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *soundPaths[NUM_SOUNDS] = {
+    "sfx.wav",
+    "win.wav",
+    "lose.wav",
+    "sounds/flip.wav",
+    "sounds/match.wav",
+    "sounds/wrong.wav",
+    "sounds/win.wav",
+    "sounds/lose.wav",
+};
+
+int initEngine(Engine *engine, int width, int height, const char *caption) {
+    memset(engine, 0, sizeof(*engine));
+    for (int i = 0; i < NUM_SOUNDS; i++)
+        engine->soundItems[i] = -1;
+    engine->musicItem = -1;
+
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_TIMER) < 0) {
+        printf("SDL_Init error: %s\n", SDL_GetError());
+        return 0;
+    }
+
+    engine->screen = SDL_SetVideoMode(width, height, 32, SDL_SWSURFACE | SDL_SRCALPHA);
+    if (!engine->screen) {
+        printf("SDL_SetVideoMode error: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 0;
+    }
+    SDL_WM_SetCaption(caption, NULL);
+
+    if (TTF_Init() == -1) {
+        printf("TTF could not initialize! TTF_Error: %s\n", TTF_GetError());
+        SDL_Quit();
+        return 0;
+    }
+
+    int imgFlags = IMG_INIT_PNG | IMG_INIT_JPG;
+    if (!(IMG_Init(imgFlags) & imgFlags)) {
+        printf("SDL_image could not initialize! SDL_image Error: %s\n", IMG_GetError());
+        TTF_Quit();
+        SDL_Quit();
+        return 0;
+    }
+
+    engine->font = acquireFont("fonti.ttf", 24);
+    engine->titleFont = acquireFont("arial.ttf", 48);
+    if (!engine->font || !engine->titleFont) {
+        printf("Failed to load fonts! TTF_Error: %s\n", TTF_GetError());
+        releaseAsset(engine->font);
+        releaseAsset(engine->titleFont);
+        purgeUnusedAssets();
+        IMG_Quit();
+        TTF_Quit();
+        SDL_Quit();
+        return 0;
+    }
+
+    // One audio device for the whole process, at a single sample rate.
+    if (Mix_OpenAudio(ENGINE_AUDIO_RATE, MIX_DEFAULT_FORMAT, 2, ENGINE_AUDIO_CHUNK) < 0) {
+        printf("Mix_OpenAudio error: %s\n", Mix_GetError());
+        releaseAsset(engine->font);
+        releaseAsset(engine->titleFont);
+        purgeUnusedAssets();
+        IMG_Quit();
+        TTF_Quit();
+        SDL_Quit();
+        return 0;
+    }
+    Mix_AllocateChannels(ENGINE_MIX_CHANNELS);
+
+    // Scaled memory tiles from a previous run, if any
+    loadTileCache(TILE_CACHE_FILE);
+    return 1;
+}
+
+void queueEnginePreloads(Engine *engine, Preloader *pre) {
+    engine->musicItem = addPreload(pre, "bgmusic.mp3", PRELOAD_MUSIC);
+    for (int i = 0; i < NUM_SOUNDS; i++)
+        engine->soundItems[i] = addPreload(pre, soundPaths[i], PRELOAD_SOUND);
+}
+
+void collectEnginePreloads(Engine *engine, Preloader *pre) {
+    if (!engine->music)
+        engine->music = takePreloaded(pre, engine->musicItem);
+    for (int i = 0; i < NUM_SOUNDS; i++) {
+        if (!engine->sounds[i] && isPreloadReady(pre, engine->soundItems[i]))
+            engine->sounds[i] = acquireSound(soundPaths[i]);
+    }
+}
+
+// Loads the sound now if the preloader has not delivered it yet.
+Mix_Chunk* getSound(Engine *engine, SoundId id) {
+    if (!engine->sounds[id])
+        engine->sounds[id] = acquireSound(soundPaths[id]);
+    return engine->sounds[id];
+}
+
+// Plays a sound only once it is loaded, never blocking on a decode.
+void playSound(Engine *engine, SoundId id) {
+    if (engine->sounds[id])
+        Mix_PlayChannel(-1, engine->sounds[id], 0);
+}
+
+void shutdownEngine(Engine *engine) {
+    saveTileCache(TILE_CACHE_FILE);
+    freeTileCache();
+
+    Mix_HaltChannel(-1);
+    Mix_HaltMusic();
+    for (int i = 0; i < NUM_SOUNDS; i++)
+        releaseAsset(engine->sounds[i]);
+    if (engine->music)
+        Mix_FreeMusic(engine->music);
+    releaseAsset(engine->font);
+    releaseAsset(engine->titleFont);
+
+    printAssetReport();
+    purgeUnusedAssets();
+    Mix_CloseAudio();
+    IMG_Quit();
+    TTF_Quit();
+    SDL_Quit();
+}
@@ -0,0 +1,45 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_mixer.h>
+#include <SDL/SDL_ttf.h>
+#include "preload.h"
+
+#define ENGINE_AUDIO_RATE 44100
+#define ENGINE_AUDIO_CHUNK 2048
+#define ENGINE_MIX_CHANNELS 16
+
+typedef enum {
+    SOUND_HOVER,
+    SOUND_QUIZ_WIN,
+    SOUND_QUIZ_LOSE,
+    SOUND_FLIP,
+    SOUND_MATCH,
+    SOUND_WRONG,
+    SOUND_PUZZLE_WIN,
+    SOUND_PUZZLE_LOSE,
+    NUM_SOUNDS
+} SoundId;
+
+// Everything that lives for the whole process: the window, the audio
+// device, fonts and sounds. Mini-games borrow from it and never open or
+// close any of these themselves, so switching modes costs nothing.
+typedef struct {
+    SDL_Surface *screen;
+    TTF_Font *font;                 // Quiz UI font
+    TTF_Font *titleFont;            // Large font for the puzzle overlays
+    Mix_Chunk *sounds[NUM_SOUNDS];
+    Mix_Music *music;
+    int soundItems[NUM_SOUNDS];     // Preloader item of each sound
+    int musicItem;
+} Engine;
+
+int initEngine(Engine *engine, int width, int height, const char *caption);
+void queueEnginePreloads(Engine *engine, Preloader *pre);
+void collectEnginePreloads(Engine *engine, Preloader *pre);
+Mix_Chunk* getSound(Engine *engine, SoundId id);
+void playSound(Engine *engine, SoundId id);
+void shutdownEngine(Engine *engine);
+
+#endif // ENGINE_H
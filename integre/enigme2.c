@@ -1,15 +1,105 @@
 #include "enigme2.h"
+#include "assets.h"
+#include "tilecache.h"
+#include "proctiles.h"
+#include "pak.h"
+#include <string.h>
 
 int SCREEN_W = 800;
 int SCREEN_H = 600;
 
-Uint32 interpolateColor(Uint32 start, Uint32 end, float ratio) {
-    int r1 = (start >> 16) & 0xFF, g1 = (start >> 8) & 0xFF, b1 = start & 0xFF;
-    int r2 = (end >> 16) & 0xFF, g2 = (end >> 8) & 0xFF, b2 = end & 0xFF;
-    int r = r1 + (int)((r2 - r1) * ratio);
-    int g = g1 + (int)((g2 - g1) * ratio);
-    int b = b1 + (int)((b2 - b1) * ratio);
-    return (r << 16) | (g << 8) | b;
+// Green with all the time left, red when it runs out.
+static const Uint32 timeStops[] = {0xFF0000FF, 0x00FF00FF};
+static Gradient timeGradient;
+
+// Tile sizes of the large-board zoom levels.
+static const int zoomSizes[MEMORY_ZOOM_LEVELS] = {24, 32, 48, 64, 80, 100};
+
+static void setBit(Uint32 *bits, int cell, int value) {
+    if (value)
+        bits[cell >> 5] |= 1u << (cell & 31);
+    else
+        bits[cell >> 5] &= ~(1u << (cell & 31));
+}
+
+SDL_Rect Memory_TileRect(const MemoryGame *game, int cell) {
+    const HitGrid *g = &game->hitGrid;
+    SDL_Rect rect = {
+        g->originX + (cell % g->cols) * g->pitchX,
+        g->originY + (cell / g->cols) * g->pitchY,
+        g->cellW,
+        g->cellH
+    };
+    return rect;
+}
+
+static void markTileDirty(MemoryGame *game, int cell) {
+    if (game->compositor)
+        markDirty(game->compositor, Memory_TileRect(game, cell));
+}
+
+static void markHudDirty(MemoryGame *game) {
+    if (game->compositor)
+        markDirty(game->compositor, (SDL_Rect){0, 0, SCREEN_W, 50});
+}
+
+// Places the board in its viewport: centred when it fits, otherwise
+// offset by the (clamped) scroll position.
+static void layoutBoard(MemoryGame *game) {
+    int tile_size = game->large ? zoomSizes[game->zoom] : TILE_SIZE;
+    int spacing = game->large ? tile_size / 8 + 2 : 20;
+    int pitch = tile_size + spacing;
+    int boardW = game->grid_size * pitch, boardH = game->grid_size * pitch;
+    SDL_Rect v = game->viewport;
+    int originX, originY;
+
+    if (boardW <= v.w) {
+        game->scrollX = 0;
+        originX = v.x + (v.w - boardW) / 2;
+    } else {
+        if (game->scrollX > boardW - v.w) game->scrollX = boardW - v.w;
+        if (game->scrollX < 0) game->scrollX = 0;
+        originX = v.x - game->scrollX;
+    }
+    if (boardH <= v.h) {
+        game->scrollY = 0;
+        originY = v.y + (v.h - boardH) / 2;
+    } else {
+        if (game->scrollY > boardH - v.h) game->scrollY = boardH - v.h;
+        if (game->scrollY < 0) game->scrollY = 0;
+        originY = v.y - game->scrollY;
+    }
+    game->hitGrid = (HitGrid){originX, originY, game->grid_size, game->grid_size,
+                              tile_size, tile_size, pitch, pitch};
+}
+
+static void scrollBoard(MemoryGame *game, int dx, int dy) {
+    game->scrollX += dx;
+    game->scrollY += dy;
+    layoutBoard(game);
+    if (game->compositor)
+        markAllDirty(game->compositor);
+}
+
+// Changes the zoom level keeping the board point under (anchorX, anchorY)
+// in place.
+static void zoomBoard(MemoryGame *game, int level, int anchorX, int anchorY) {
+    if (level < 0) level = 0;
+    if (level >= MEMORY_ZOOM_LEVELS) level = MEMORY_ZOOM_LEVELS - 1;
+    if (level == game->zoom)
+        return;
+    int oldPitch = game->hitGrid.pitchX;
+    int boardX = anchorX - game->hitGrid.originX, boardY = anchorY - game->hitGrid.originY;
+    game->zoom = level;
+    layoutBoard(game);
+    int newPitch = game->hitGrid.pitchX;
+    game->scrollX = boardX * newPitch / oldPitch - (anchorX - game->viewport.x);
+    game->scrollY = boardY * newPitch / oldPitch - (anchorY - game->viewport.y);
+    layoutBoard(game);
+    // Faces are fetched again at the new size.
+    memset(game->images, 0, game->total_pairs * sizeof(SDL_Surface *));
+    if (game->compositor)
+        markAllDirty(game->compositor);
 }
 
 SDL_Surface* CreateDummySurfaceDynamic(int tile_size) {
@@ -20,116 +110,162 @@ SDL_Surface* CreateDummySurfaceDynamic(int tile_size) {
     return surf;
 }
 
-void initialiser_enigme(MemoryGame *game, const char *img_dir, int grid_size, int difficulty) {
-    srand(time(NULL));
+// Allocates and shuffles the board. The images are left NULL for the
+// caller to fill in. Returns 0 if the allocation fails.
+int Memory_InitBoard(MemoryGame *game, int grid_size, int difficulty) {
+    memset(game, 0, sizeof(*game));
     game->grid_size = grid_size;
     game->difficulty = difficulty;
-    int spacing = 20;
-    int tile_size = TILE_SIZE;
-    
-    int total_cells = grid_size * grid_size;
-    game->total_pairs = total_cells / 2;
-    game->matches = 0;
+    game->cells = grid_size * grid_size;
+    game->total_pairs = game->cells / 2;
     game->start_time = SDL_GetTicks();
+    game->large = (grid_size > MEMORY_MAX_IMAGE_GRID);
     game->total_time = (difficulty == 3) ? 20 : 30;
+    if (game->large)
+        game->total_time = game->cells;   // One second per tile
     game->time_left = game->total_time;
-    game->game_over = 0;
     game->selected[0] = -1;
     game->selected[1] = -1;
-    game->dummy = NULL;
-    game->score = 0;
-    
-    // Allocate arrays.
-    game->tiles = malloc(grid_size * sizeof(SDL_Surface **));
-    game->positions = malloc(grid_size * sizeof(SDL_Rect *));
-    game->flipped = malloc(grid_size * sizeof(int *));
-    for (int i = 0; i < grid_size; i++) {
-        game->tiles[i] = malloc(grid_size * sizeof(SDL_Surface *));
-        game->positions[i] = malloc(grid_size * sizeof(SDL_Rect));
-        game->flipped[i] = malloc(grid_size * sizeof(int));
-        for (int j = 0; j < grid_size; j++)
-            game->flipped[i][j] = 0;
+    game->preview = (grid_size > 2 && !game->large);
+
+    // One block: image pointers, both bitsets, then the 16-bit tile ids.
+    int words = MEMORY_BIT_WORDS(game->cells);
+    size_t imagesBytes = game->total_pairs * sizeof(SDL_Surface *);
+    size_t bitsBytes = words * sizeof(Uint32);
+    game->board = calloc(1, imagesBytes + 2 * bitsBytes + game->cells * sizeof(Uint16));
+    if (!game->board) {
+        fprintf(stderr, "Erreur : allocation du plateau %dx%d impossible\n", grid_size, grid_size);
+        return 0;
     }
-    
+    game->images = game->board;
+    game->flippedBits = (Uint32 *)((char *)game->board + imagesBytes);
+    game->matchedBits = game->flippedBits + words;
+    game->tileIds = (Uint16 *)(game->matchedBits + words);
+
+    // Create and shuffle pairs.
+    for (int i = 0; i < game->total_pairs; i++) {
+        game->tileIds[i * 2] = i;
+        game->tileIds[i * 2 + 1] = i;
+    }
+    for (int i = 0; i < game->cells; i++) {
+        int j = rand() % game->cells;
+        Uint16 temp = game->tileIds[i];
+        game->tileIds[i] = game->tileIds[j];
+        game->tileIds[j] = temp;
+    }
+
+    // Large boards scroll under the HUD, starting at a mid zoom level.
+    if (game->large) {
+        game->viewport = (SDL_Rect){0, 50, SCREEN_W, SCREEN_H - 50};
+        game->zoom = 2;
+    } else {
+        game->viewport = (SDL_Rect){0, 0, SCREEN_W, SCREEN_H};
+    }
+    layoutBoard(game);
+    return 1;
+}
+
+// Image file of tile index (0 .. MEMORY_IMAGE_COUNT - 1).
+void Memory_TilePath(char *path, size_t size, const char *img_dir, int index) {
+    snprintf(path, size, "%s/images/%d.jpg", img_dir, index + 1);
+}
+
+void initialiser_enigme(MemoryGame *game, const char *img_dir, int grid_size, int difficulty) {
+    srand(time(NULL));
+    if (!Memory_InitBoard(game, grid_size, difficulty))
+        exit(1);
+
+    // Large boards draw generated faces on demand (see Memory_Render).
+    if (game->large)
+        return;
+
     // Load images.
-    game->images = malloc(game->total_pairs * sizeof(SDL_Surface *));
     for (int i = 0; i < game->total_pairs; i++) {
         char path[256];
-        snprintf(path, sizeof(path), "%s/images/%d.jpg", img_dir, i + 1);
-        FILE *fp = fopen(path, "r");
-        if (!fp) {
+        Memory_TilePath(path, sizeof(path), img_dir, i);
+        // Scaled tiles live in the tile cache across rounds.
+        game->images[i] = getScaledTile(path, TILE_SIZE);
+        if (!game->images[i]) {
+            if (assetMtime(path) >= 0)
+                exit(1);   // The file exists but could not be decoded or scaled
             printf("Warning: file not found: %s. Using dummy image.\n", path);
-            game->images[i] = CreateDummySurfaceDynamic(tile_size);
-        } else {
-            fclose(fp);
-            SDL_Surface *original = IMG_Load(path);
-            if (!original) {
-                printf("Error loading image: %s\n", path);
-                exit(1);
-            }
-            game->images[i] = rotozoomSurface(original, 0, (double)tile_size / original->w, 1);
-            SDL_FreeSurface(original);
-            if (!game->images[i]) {
-                printf("Error scaling image: %s\n", path);
-                exit(1);
-            }
+            game->images[i] = storeScaledTile(path, TILE_SIZE,
+                optimizeOpaqueSurface(CreateDummySurfaceDynamic(TILE_SIZE)));
         }
     }
-    
-    // Create and shuffle pairs.
-    int *pairs = malloc(total_cells * sizeof(int));
-    for (int i = 0; i < game->total_pairs; i++) {
-        pairs[i * 2] = i;
-        pairs[i * 2 + 1] = i;
-    }
-    for (int i = 0; i < total_cells; i++) {
-        int j = rand() % total_cells;
-        int temp = pairs[i];
-        pairs[i] = pairs[j];
-        pairs[j] = temp;
-    }
-    
-    int start_x = (SCREEN_W - (grid_size * (tile_size + spacing))) / 2;
-    int start_y = (SCREEN_H - (grid_size * (tile_size + spacing))) / 2;
-    for (int i = 0; i < grid_size; i++) {
-        for (int j = 0; j < grid_size; j++) {
-            int idx = pairs[i * grid_size + j];
-            game->tiles[i][j] = game->images[idx];
-            game->positions[i][j] = (SDL_Rect){
-                start_x + j * (tile_size + spacing),
-                start_y + i * (tile_size + spacing),
-                tile_size,
-                tile_size
-            };
+}
+
+// Scrolling (arrows, page keys, right-button drag) and zoom (+/-, wheel)
+// of large boards. Returns 1 if the event was used.
+static int Memory_HandleViewEvent(MemoryGame *game, SDL_Event *ev) {
+    int step = game->hitGrid.pitchX * 2;
+    switch (ev->type) {
+    case SDL_KEYDOWN:
+        switch (ev->key.keysym.sym) {
+        case SDLK_LEFT: scrollBoard(game, -step, 0); return 1;
+        case SDLK_RIGHT: scrollBoard(game, step, 0); return 1;
+        case SDLK_UP: scrollBoard(game, 0, -step); return 1;
+        case SDLK_DOWN: scrollBoard(game, 0, step); return 1;
+        case SDLK_PAGEUP: scrollBoard(game, 0, -game->viewport.h); return 1;
+        case SDLK_PAGEDOWN: scrollBoard(game, 0, game->viewport.h); return 1;
+        case SDLK_PLUS:
+        case SDLK_EQUALS:
+        case SDLK_KP_PLUS:
+            zoomBoard(game, game->zoom + 1, game->viewport.x + game->viewport.w / 2,
+                      game->viewport.y + game->viewport.h / 2);
+            return 1;
+        case SDLK_MINUS:
+        case SDLK_KP_MINUS:
+            zoomBoard(game, game->zoom - 1, game->viewport.x + game->viewport.w / 2,
+                      game->viewport.y + game->viewport.h / 2);
+            return 1;
+        default:
+            return 0;
+        }
+    case SDL_MOUSEBUTTONDOWN:
+        if (ev->button.button == SDL_BUTTON_WHEELUP) {
+            zoomBoard(game, game->zoom + 1, ev->button.x, ev->button.y);
+            return 1;
+        }
+        if (ev->button.button == SDL_BUTTON_WHEELDOWN) {
+            zoomBoard(game, game->zoom - 1, ev->button.x, ev->button.y);
+            return 1;
+        }
+        return 0;
+    case SDL_MOUSEMOTION:
+        if (ev->motion.state & SDL_BUTTON_RMASK) {
+            scrollBoard(game, -ev->motion.xrel, -ev->motion.yrel);
+            return 1;
         }
+        return 0;
     }
-    free(pairs);
+    return 0;
 }
 
 void Memory_HandleEvent(MemoryGame *game, SDL_Event *ev) {
     if (game->game_over)
         return;
-    if (ev->type == SDL_MOUSEBUTTONDOWN) {
+    if (game->large && Memory_HandleViewEvent(game, ev))
+        return;
+    if (ev->type == SDL_MOUSEBUTTONDOWN && ev->button.button == SDL_BUTTON_LEFT) {
+        // Tiles scrolled under the HUD are not drawn, so they cannot be clicked.
+        const SDL_Rect *view = &game->viewport;
         int x = ev->button.x, y = ev->button.y;
-        for (int i = 0; i < game->grid_size; i++) {
-            for (int j = 0; j < game->grid_size; j++) {
-                SDL_Rect pos = game->positions[i][j];
-                if (x >= pos.x && x <= pos.x + pos.w &&
-                    y >= pos.y && y <= pos.y + pos.h &&
-                    !game->flipped[i][j])
-                {
-                    int cell_index = i * game->grid_size + j;
-                    if (game->selected[0] == -1) {
-                        game->selected[0] = cell_index;
-                        game->flipped[i][j] = 1;
-                        Mix_PlayChannel(-1, flipSound, 0);
-                    } else if (game->selected[1] == -1) {
-                        game->selected[1] = cell_index;
-                        game->flipped[i][j] = 1;
-                        Mix_PlayChannel(-1, flipSound, 0);
-                    }
-                }
-            }
+        if (x < view->x || y < view->y || x >= view->x + view->w || y >= view->y + view->h)
+            return;
+        int cell_index = hitTestGrid(&game->hitGrid, x, y);
+        if (cell_index == NO_HIT || isTileFlipped(game, cell_index))
+            return;
+        if (game->selected[0] == -1) {
+            game->selected[0] = cell_index;
+            setBit(game->flippedBits, cell_index, 1);
+            markTileDirty(game, cell_index);
+            Mix_PlayChannel(-1, flipSound, 0);
+        } else if (game->selected[1] == -1) {
+            game->selected[1] = cell_index;
+            setBit(game->flippedBits, cell_index, 1);
+            markTileDirty(game, cell_index);
+            Mix_PlayChannel(-1, flipSound, 0);
         }
     }
 }
@@ -141,12 +277,13 @@ void Memory_Update(MemoryGame *game) {
     
     static Uint32 mismatch_time = 0;
     if (game->selected[0] != -1 && game->selected[1] != -1) {
-        int i1 = game->selected[0] / game->grid_size;
-        int j1 = game->selected[0] % game->grid_size;
-        int i2 = game->selected[1] / game->grid_size;
-        int j2 = game->selected[1] % game->grid_size;
-        if (game->tiles[i1][j1] == game->tiles[i2][j2]) {
+        int first = game->selected[0];
+        int second = game->selected[1];
+        if (game->tileIds[first] == game->tileIds[second]) {
+            setBit(game->matchedBits, first, 1);
+            setBit(game->matchedBits, second, 1);
             game->matches++;
+            markHudDirty(game);
             game->selected[0] = -1;
             game->selected[1] = -1;
             Mix_PlayChannel(-1, matchSound, 0);
@@ -158,8 +295,10 @@ void Memory_Update(MemoryGame *game) {
             if (mismatch_time == 0)
                 mismatch_time = SDL_GetTicks();
             if (SDL_GetTicks() - mismatch_time > reveal_delay) {
-                game->flipped[i1][j1] = 0;
-                game->flipped[i2][j2] = 0;
+                setBit(game->flippedBits, first, 0);
+                setBit(game->flippedBits, second, 0);
+                markTileDirty(game, first);
+                markTileDirty(game, second);
                 game->selected[0] = -1;
                 game->selected[1] = -1;
                 mismatch_time = 0;
@@ -171,6 +310,7 @@ void Memory_Update(MemoryGame *game) {
     }
     
     Uint32 current_time = SDL_GetTicks();
+    int previous_time_left = game->time_left;
     game->time_left = game->total_time - (current_time - game->start_time) / 1000;
     if (game->time_left <= 0) {
         if (!game->game_over) {
@@ -180,8 +320,23 @@ void Memory_Update(MemoryGame *game) {
                 Mix_PlayChannel(-1, loseSound, 0);
         }
     }
-    if (game->game_over)
+    if (game->time_left != previous_time_left) {
+        // Below 5 seconds the red overlay covers the whole screen.
+        if (game->time_left < 5 && game->compositor)
+            markAllDirty(game->compositor);
+        else
+            markHudDirty(game);
+    }
+    if (game->preview && (current_time - game->start_time) >= 3000) {
+        game->preview = 0;
+        if (game->compositor)
+            markAllDirty(game->compositor);
+    }
+    if (game->game_over) {
         game->score = game->matches * game->time_left;
+        if (game->compositor)
+            markAllDirty(game->compositor);
+    }
 }
 
 void Memory_Render(MemoryGame *game, SDL_Surface *screen) {
@@ -194,30 +349,52 @@ void Memory_Render(MemoryGame *game, SDL_Surface *screen) {
         bgColor = SDL_MapRGB(screen->format, 139, 0, 0);
     SDL_FillRect(screen, NULL, bgColor);
     
-    Uint32 current_time = SDL_GetTicks();
-    int preview = (game->grid_size > 2 && ((current_time - game->start_time) < 3000));
-    for (int i = 0; i < game->grid_size; i++) {
-        for (int j = 0; j < game->grid_size; j++) {
-            SDL_Rect pos = game->positions[i][j];
-            if (preview)
-                SDL_BlitSurface(game->tiles[i][j], NULL, screen, &pos);
-            else {
-                if (game->flipped[i][j])
-                    SDL_BlitSurface(game->tiles[i][j], NULL, screen, &pos);
-                else {
-                    SDL_FillRect(screen, &pos, SDL_MapRGB(screen->format, 100, 100, 150));
+    // Only the tiles that intersect both the region being redrawn and the
+    // viewport are visited, so the cost follows the screen, not the board.
+    SDL_Rect clip, area;
+    SDL_GetClipRect(screen, &clip);
+    int x0 = clip.x > game->viewport.x ? clip.x : game->viewport.x;
+    int y0 = clip.y > game->viewport.y ? clip.y : game->viewport.y;
+    int x1 = (clip.x + clip.w < game->viewport.x + game->viewport.w) ? clip.x + clip.w : game->viewport.x + game->viewport.w;
+    int y1 = (clip.y + clip.h < game->viewport.y + game->viewport.h) ? clip.y + clip.h : game->viewport.y + game->viewport.h;
+    const HitGrid *g = &game->hitGrid;
+    if (x1 > x0 && y1 > y0 && x1 > g->originX && y1 > g->originY) {
+        area = (SDL_Rect){x0, y0, x1 - x0, y1 - y0};
+        SDL_SetClipRect(screen, &area);
+        int c0 = x0 > g->originX ? (x0 - g->originX) / g->pitchX : 0;
+        int r0 = y0 > g->originY ? (y0 - g->originY) / g->pitchY : 0;
+        int c1 = (x1 - 1 - g->originX) / g->pitchX;
+        int r1 = (y1 - 1 - g->originY) / g->pitchY;
+        if (c1 >= g->cols) c1 = g->cols - 1;
+        if (r1 >= g->rows) r1 = g->rows - 1;
+
+        int preview = game->preview;
+        Uint32 backColor = SDL_MapRGB(screen->format, 100, 100, 150);
+        for (int row = r0; row <= r1; row++) {
+            for (int col = c0; col <= c1; col++) {
+                int cell = row * g->cols + col;
+                SDL_Rect pos = Memory_TileRect(game, cell);
+                if (preview || isTileFlipped(game, cell)) {
+                    int id = game->tileIds[cell];
+                    if (!game->images[id] && game->large)
+                        game->images[id] = getProceduralTile(id, g->cellW);
+                    SDL_BlitSurface(game->images[id], NULL, screen, &pos);
+                } else {
+                    SDL_FillRect(screen, &pos, backColor);
                     rectangleColor(screen, pos.x, pos.y, pos.x + pos.w, pos.y + pos.h, 0xFFFFFFFF);
                 }
             }
         }
+        SDL_SetClipRect(screen, &clip);
     }
     
     int bar_width = 400, bar_height = 25;
     int bar_x = (SCREEN_W - bar_width) / 2, bar_y = 20;
-    boxColor(screen, bar_x, bar_y, bar_x + bar_width, bar_y + bar_height, 0x505050FF);
-    int current_width = (game->time_left / (float)game->total_time) * bar_width;
-    Uint32 color = interpolateColor(0x00FF00FF, 0xFF0000FF, 1 - (game->time_left/(float)game->total_time));
-    boxColor(screen, bar_x, bar_y, bar_x + current_width, bar_y + bar_height, color);
+    if (!timeGradient.stopCount)
+        initGradient(&timeGradient, timeStops, 2);
+    SDL_Rect bar = {bar_x, bar_y, bar_width + 1, bar_height + 1};
+    drawProgressBar(screen, &timeGradient, bar, game->time_left / (float)game->total_time,
+                    SDL_MapRGB(screen->format, 80, 80, 80), 0);
     
     char buffer[50];
     snprintf(buffer, sizeof(buffer), "Pairs: %d/%d", game->matches, game->total_pairs);
@@ -226,7 +403,9 @@ void Memory_Render(MemoryGame *game, SDL_Surface *screen) {
     stringColor(screen, 10, 10, buffer, 0xFFFFFFFF);
     
     const char *levelLabel;
-    if (game->difficulty == 1)
+    if (game->large)
+        levelLabel = "Large board";
+    else if (game->difficulty == 1)
         levelLabel = "Level 1 - Easy";
     else if (game->difficulty == 2)
         levelLabel = "Level 2 - Hard";
@@ -250,40 +429,28 @@ void Memory_Render(MemoryGame *game, SDL_Surface *screen) {
         
         const char *msg = (game->matches == game->total_pairs) ? "YOU WON" : "YOU LOST";
         SDL_Color textColor = {0, 0, 0, 255};
-        SDL_Surface *msgSurface = TTF_RenderText_Blended(gFont, msg, textColor);
+        SDL_Surface *msgSurface = getCachedText(&gTextCache, gFont, textColor, msg);
         if (msgSurface) {
             SDL_Rect msgRect;
             msgRect.x = (SCREEN_W - msgSurface->w) / 2;
             msgRect.y = SCREEN_H - 150 + 20;
             SDL_BlitSurface(msgSurface, NULL, screen, &msgRect);
-            SDL_FreeSurface(msgSurface);
         }
         
         char scoreBuffer[50];
         snprintf(scoreBuffer, sizeof(scoreBuffer), "Your Score: %d", game->score);
-        SDL_Surface *scoreSurface = TTF_RenderText_Blended(gFont, scoreBuffer, textColor);
+        SDL_Surface *scoreSurface = getCachedText(&gTextCache, gFont, textColor, scoreBuffer);
         if (scoreSurface) {
             SDL_Rect scoreRect;
             scoreRect.x = (SCREEN_W - scoreSurface->w) / 2;
             scoreRect.y = SCREEN_H - 150 + 80;
             SDL_BlitSurface(scoreSurface, NULL, screen, &scoreRect);
-            SDL_FreeSurface(scoreSurface);
         }
     }
 }
 
 void Memory_Cleanup(MemoryGame *game) {
-    for (int i = 0; i < game->total_pairs; i++)
-        SDL_FreeSurface(game->images[i]);
-    free(game->images);
-    for (int i = 0; i < game->grid_size; i++) {
-        free(game->tiles[i]);
-        free(game->positions[i]);
-        free(game->flipped[i]);
-    }
-    free(game->tiles);
-    free(game->positions);
-    free(game->flipped);
-    if (game->dummy)
-        SDL_FreeSurface(game->dummy);
+    // The images themselves belong to the tile cache.
+    free(game->board);
+    game->board = NULL;
 }
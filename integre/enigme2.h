@@ -10,10 +10,18 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
+#include "textcache.h"
+#include "compositor.h"
+#include "hittest.h"
+#include "gradient.h"
 
 extern int SCREEN_W;
 extern int SCREEN_H;
 #define TILE_SIZE 100
+#define MEMORY_MAX_IMAGE_GRID 4    // Larger boards use generated tiles and a viewport
+#define MEMORY_LARGE_BOARD 20      // Grid size of the puzzle's large-board mode
+#define MEMORY_ZOOM_LEVELS 6
+#define MEMORY_IMAGE_COUNT (MEMORY_MAX_IMAGE_GRID * MEMORY_MAX_IMAGE_GRID / 2)   // Tile images on disk
 
 extern Mix_Chunk *flipSound;
 extern Mix_Chunk *matchSound;
@@ -21,29 +29,53 @@ extern Mix_Chunk *wrongSound;
 extern Mix_Chunk *winSound;
 extern Mix_Chunk *loseSound;
 extern TTF_Font *gFont;
+extern TextCache gTextCache;
 
-Uint32 interpolateColor(Uint32 start, Uint32 end, float ratio);
 SDL_Surface* CreateDummySurfaceDynamic(int tile_size);
 
+// The whole board lives in one allocation (board): the image table, the
+// flipped and matched bitsets and one small tile id per cell. Tile
+// positions are computed from hitGrid instead of being stored.
 typedef struct {
     int grid_size;         // 2 for 2×2, 4 for 4×4.
     int total_pairs;       // (grid_size * grid_size) / 2
-    SDL_Surface ***tiles;  // 2D array [grid_size][grid_size]
+    int cells;             // grid_size * grid_size
+    void *board;           // Single block backing the four arrays below
     SDL_Surface **images;  // Array of images; size: total_pairs
-    SDL_Rect **positions;  // Each tile's position
-    int **flipped;         // 0 or 1; tile face up?
+    Uint32 *flippedBits;   // One bit per cell: face up
+    Uint32 *matchedBits;   // One bit per cell: part of a found pair
+    Uint16 *tileIds;       // Image index shown by each cell
+    HitGrid hitGrid;       // Board layout on screen; maps a click straight to its cell
+    int large;             // Generated tiles, scrolling and zoom (grid > MEMORY_MAX_IMAGE_GRID)
+    SDL_Rect viewport;     // Screen area the board is drawn in
+    int scrollX, scrollY;  // Board pixels hidden left of / above the viewport
+    int zoom;              // Index into the tile sizes of the large mode
     int selected[2];       // Flattened indices; -1 means none selected.
     int matches;
     Uint32 start_time;
     int total_time;        // In seconds; level dependent.
     int time_left;
     int game_over;
-    SDL_Surface *dummy;    // (unused)
     int score;             // Calculated as game->matches * game->time_left
     int difficulty;        // 1 = Easy, 2 = Hard, 3 = Extreme.
+    int preview;           // All tiles shown face up at the start of the round.
+    Compositor *compositor; // Receives the regions that change (may be NULL).
 } MemoryGame;
 
+#define MEMORY_BIT_WORDS(cells) (((cells) + 31) / 32)
+
+static inline int isTileFlipped(const MemoryGame *game, int cell) {
+    return (game->flippedBits[cell >> 5] >> (cell & 31)) & 1;
+}
+
+static inline int isTileMatched(const MemoryGame *game, int cell) {
+    return (game->matchedBits[cell >> 5] >> (cell & 31)) & 1;
+}
+
+int Memory_InitBoard(MemoryGame *game, int grid_size, int difficulty);
 void initialiser_enigme(MemoryGame *game, const char *img_dir, int grid_size, int difficulty);
+SDL_Rect Memory_TileRect(const MemoryGame *game, int cell);
+void Memory_TilePath(char *path, size_t size, const char *img_dir, int index);
 void Memory_HandleEvent(MemoryGame *game, SDL_Event *ev);
 void Memory_Update(MemoryGame *game);
 void Memory_Render(MemoryGame *game, SDL_Surface *screen);
@@ -0,0 +1,145 @@
+#include "frameloop.h"
+#include <stdio.h>
+#include <string.h>
+
+void initFrameLoop(FrameLoop *loop, int updateHz, int targetFps) {
+    memset(loop, 0, sizeof(*loop));
+    loop->updateHz = updateHz > 0 ? updateHz : 60;
+    loop->stepMs = (1000 + loop->updateHz / 2) / loop->updateHz;
+    if (loop->stepMs == 0)
+        loop->stepMs = 1;
+    loop->frameMs = targetFps > 0 ? 1000 / targetFps : 0;
+    loop->maxSteps = 10;
+    loop->minFrameMs = 0xFFFFFFFF;
+}
+
+// Starts a frame and returns how many fixed steps are due.
+int beginFrame(FrameLoop *loop) {
+    Uint32 now = SDL_GetTicks();
+    if (loop->frames == 0 && loop->previous == 0) {
+        loop->previous = now;
+    } else {
+        Uint32 frameTime = now - loop->frameStart;
+        loop->totalFrameMs += frameTime;
+        if (frameTime < loop->minFrameMs) loop->minFrameMs = frameTime;
+        if (frameTime > loop->maxFrameMs) loop->maxFrameMs = frameTime;
+        loop->histogram[frameTime < FRAME_HISTOGRAM_MS ? frameTime : FRAME_HISTOGRAM_MS - 1]++;
+        loop->frames++;
+    }
+    loop->frameStart = now;
+
+    // Counted in 1/updateHz ms so a step is exactly 1000 units: 60 Hz
+    // really runs 60 steps a second instead of 1000 / 16.
+    loop->accumulator += (now - loop->previous) * loop->updateHz;
+    loop->previous = now;
+    int steps = loop->accumulator / FRAME_STEP_UNITS;
+    if (steps > (int)loop->maxSteps) {
+        // A long stall is not replayed step by step.
+        loop->droppedMs += (steps - loop->maxSteps) * FRAME_STEP_UNITS / loop->updateHz;
+        steps = loop->maxSteps;
+    }
+    loop->accumulator -= steps * FRAME_STEP_UNITS;
+    if (loop->accumulator >= FRAME_STEP_UNITS)
+        loop->accumulator %= FRAME_STEP_UNITS;
+    loop->steps += steps;
+    return steps;
+}
+
+// How far the current time is between the last step and the next one.
+float getFrameAlpha(const FrameLoop *loop) {
+    return (float)loop->accumulator / FRAME_STEP_UNITS;
+}
+
+// Sleeps until the next frame deadline. Deadlines advance by frameMs, so
+// a short frame does not shift the ones after it; a missed deadline
+// restarts the schedule from now rather than rushing to catch up.
+void endFrame(FrameLoop *loop) {
+    Uint32 now = SDL_GetTicks();
+    loop->busyMs += now - loop->frameStart;
+    if (loop->frameMs == 0)
+        return;
+    if (loop->nextFrame == 0)
+        loop->nextFrame = loop->frameStart + loop->frameMs;
+    if ((Sint32)(loop->nextFrame - now) > 0) {
+        SDL_Delay(loop->nextFrame - now);
+        loop->nextFrame += loop->frameMs;
+    } else {
+        loop->lateFrames++;
+        loop->nextFrame = now + loop->frameMs;
+    }
+}
+
+static Uint32 pushWakeEvent(Uint32 interval, void *param) {
+    SDL_Event event;
+    memset(&event, 0, sizeof(event));
+    event.type = SDL_USEREVENT;
+    event.user.code = FRAME_WAKE_EVENT;
+    SDL_PushEvent(&event);
+    return 0;   // One-shot
+}
+
+int isWakeEvent(const SDL_Event *event) {
+    return event->type == SDL_USEREVENT && event->user.code == FRAME_WAKE_EVENT;
+}
+
+// Blocks until an event arrives or timeoutMs passes (SDL 1.2 has no timed
+// wait, so a one-shot timer pushes a wake event). Nothing is taken off the
+// queue, so the normal poll sees events in their order. Time spent here is kept out of the
+// frame statistics, and the next frame always runs at least one step.
+void idleFrameLoop(FrameLoop *loop, Uint32 timeoutMs) {
+    SDL_TimerID timer = NULL;
+    SDL_Event event;
+    Uint32 start = SDL_GetTicks();
+
+    if (timeoutMs == 0)
+        return;
+    if (timeoutMs != FRAME_WAIT_INPUT)
+        timer = SDL_AddTimer(timeoutMs, pushWakeEvent, NULL);
+    int woke = SDL_WaitEvent(NULL);
+    if (timer)
+        SDL_RemoveTimer(timer);
+
+    // Whatever heads the queue ended the wait.
+    if (woke && SDL_PeepEvents(&event, 1, SDL_PEEKEVENT, SDL_ALLEVENTS) == 1 && isWakeEvent(&event))
+        loop->timerWakeups++;
+    else
+        loop->inputWakeups++;
+    loop->idleWaits++;
+
+    Uint32 waited = SDL_GetTicks() - start;
+    loop->idleMs += waited;
+    loop->frameStart += waited;
+    loop->previous += waited;
+    loop->nextFrame = 0;
+    if (loop->accumulator < FRAME_STEP_UNITS)
+        loop->accumulator = FRAME_STEP_UNITS;
+}
+
+static Uint32 histogramPercentile(const FrameLoop *loop, double fraction) {
+    unsigned long target = (unsigned long)(loop->frames * fraction);
+    unsigned long seen = 0;
+    for (Uint32 ms = 0; ms < FRAME_HISTOGRAM_MS; ms++) {
+        seen += loop->histogram[ms];
+        if (seen > target)
+            return ms;
+    }
+    return FRAME_HISTOGRAM_MS - 1;
+}
+
+void printFrameStats(const FrameLoop *loop) {
+    if (loop->frames == 0)
+        return;
+    Uint32 elapsed = loop->totalFrameMs ? loop->totalFrameMs : 1;
+    printf("Frames: %lu (%.1f fps), steps: %lu at %u Hz, target %u ms\n",
+           loop->frames, 1000.0 * loop->frames / elapsed, loop->steps, loop->updateHz, loop->frameMs);
+    printf("Frame time: min %u, avg %.2f, p50 %u, p95 %u, p99 %u, max %u ms\n",
+           loop->minFrameMs, (double)loop->totalFrameMs / loop->frames,
+           histogramPercentile(loop, 0.50), histogramPercentile(loop, 0.95),
+           histogramPercentile(loop, 0.99), loop->maxFrameMs);
+    printf("Busy %.1f%%, %lu late frames, %u ms of backlog dropped\n",
+           100.0 * loop->busyMs / elapsed, loop->lateFrames, loop->droppedMs);
+    Uint32 wallMs = loop->totalFrameMs + loop->idleMs;
+    printf("Idle %.1f%% of %u ms: %lu waits, %lu woken by input, %lu by timeout\n",
+           wallMs ? 100.0 * loop->idleMs / wallMs : 0.0, wallMs, loop->idleWaits,
+           loop->inputWakeups, loop->timerWakeups);
+}
@@ -0,0 +1,46 @@
+#ifndef FRAMELOOP_H
+#define FRAMELOOP_H
+
+#include <SDL/SDL.h>
+
+#define FRAME_HISTOGRAM_MS 64   // Last bucket counts every longer frame
+#define FRAME_WAIT_INPUT 0xFFFFFFFF  // Idle until an event arrives, no timeout
+#define FRAME_WAKE_EVENT 0x46574b    // SDL_USEREVENT code of the idle timeout
+#define FRAME_STEP_UNITS 1000        // One step in the accumulator (ms * updateHz)
+
+// Fixed-timestep driver: game logic advances updateHz steps a second whatever
+// the render rate, rendering can interpolate between the last two steps,
+// and frames are paced against a deadline instead of a flat delay.
+typedef struct {
+    Uint32 updateHz;
+    Uint32 stepMs;           // Nominal step passed to updates, rounded
+    Uint32 frameMs;          // Target frame time, 0 = unpaced
+    Uint32 maxSteps;         // Steps per frame before the backlog is dropped
+    Uint32 accumulator;      // In FRAME_STEP_UNITS per step
+    Uint32 previous;
+    Uint32 frameStart;
+    Uint32 nextFrame;        // Pacing deadline
+    // Statistics
+    unsigned long frames;
+    unsigned long steps;
+    unsigned long lateFrames;    // Missed the pacing deadline
+    Uint32 droppedMs;            // Backlog thrown away after stalls
+    Uint32 busyMs;               // Time spent outside the pacing sleep
+    Uint32 minFrameMs, maxFrameMs, totalFrameMs;
+    unsigned long histogram[FRAME_HISTOGRAM_MS];
+    // Idle mode
+    Uint32 idleMs;               // Time blocked waiting for input or a timeout
+    unsigned long idleWaits;
+    unsigned long inputWakeups;
+    unsigned long timerWakeups;
+} FrameLoop;
+
+void initFrameLoop(FrameLoop *loop, int updateHz, int targetFps);
+int beginFrame(FrameLoop *loop);
+float getFrameAlpha(const FrameLoop *loop);
+void endFrame(FrameLoop *loop);
+void idleFrameLoop(FrameLoop *loop, Uint32 timeoutMs);
+int isWakeEvent(const SDL_Event *event);
+void printFrameStats(const FrameLoop *loop);
+
+#endif // FRAMELOOP_H
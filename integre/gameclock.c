@@ -0,0 +1,54 @@
+#include "gameclock.h"
+#include <stdlib.h>
+#include <time.h>
+
+Uint64 gameClockUs(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
+        return (Uint64)ts.tv_sec * 1000000 + (Uint64)ts.tv_nsec / 1000;
+#endif
+    return (Uint64)SDL_GetTicks() * 1000;
+}
+
+void recordResponse(ResponseLog *log, const ResponseRecord *record) {
+    if (log->count < MAX_LOGGED_RESPONSES)
+        log->records[log->count++] = *record;
+}
+
+static int compareTimes(const void *a, const void *b) {
+    Uint64 x = *(const Uint64 *)a, y = *(const Uint64 *)b;
+    return (x > y) - (x < y);
+}
+
+void printResponseStats(const ResponseLog *log) {
+    if (log->count == 0)
+        return;
+    Uint64 times[MAX_LOGGED_RESPONSES];
+    Uint64 total = 0;
+    int correct = 0;
+    for (int i = 0; i < log->count; i++) {
+        times[i] = log->records[i].responseUs;
+        total += times[i];
+        correct += log->records[i].correct;
+    }
+    qsort(times, log->count, sizeof(Uint64), compareTimes);
+    printf("Answers: %d (%d correct), response time: min %.3f, avg %.3f, p50 %.3f, p90 %.3f, max %.3f s\n",
+           log->count, correct, times[0] / 1e6, total / 1e6 / log->count, times[log->count / 2] / 1e6,
+           times[log->count * 9 / 10] / 1e6, times[log->count - 1] / 1e6);
+}
+
+int appendResponseLog(const ResponseLog *log, const char *path) {
+    FILE *fp = fopen(path, "a");
+    if (!fp)
+        return 0;
+    fseek(fp, 0, SEEK_END);
+    if (ftell(fp) == 0)
+        fprintf(fp, "question,category,difficulty,correct,response_us\n");
+    for (int i = 0; i < log->count; i++) {
+        const ResponseRecord *r = &log->records[i];
+        fprintf(fp, "%d,%d,%d,%d,%llu\n", r->id, r->category, r->difficulty, r->correct,
+                (unsigned long long)r->responseUs);
+    }
+    return fclose(fp) == 0;
+}
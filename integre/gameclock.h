@@ -0,0 +1,33 @@
+#ifndef GAMECLOCK_H
+#define GAMECLOCK_H
+
+#include <SDL/SDL.h>
+#include <stdio.h>
+
+#define RESPONSE_LOG_FILE "responses.csv"
+#define MAX_LOGGED_RESPONSES 64
+
+// Microseconds on a monotonic clock: unlike SDL_GetTicks() it has
+// sub-millisecond resolution and never jumps with the wall clock.
+Uint64 gameClockUs(void);
+
+typedef struct {
+    int id;                    // Question id in the bank
+    int category;
+    int difficulty;
+    int correct;
+    Uint64 responseUs;         // From the question appearing to the click
+} ResponseRecord;
+
+// Answers given during one quiz round.
+typedef struct {
+    ResponseRecord records[MAX_LOGGED_RESPONSES];
+    int count;
+} ResponseLog;
+
+void recordResponse(ResponseLog *log, const ResponseRecord *record);
+void printResponseStats(const ResponseLog *log);
+// Appends one CSV line per answer, with a header when the file is new.
+int appendResponseLog(const ResponseLog *log, const char *path);
+
+#endif // GAMECLOCK_H
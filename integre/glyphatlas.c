@@ -0,0 +1,117 @@
+#include "glyphatlas.h"
+#include <stdio.h>
+#include <string.h>
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define ATLAS_RMASK 0xFF000000
+#define ATLAS_GMASK 0x00FF0000
+#define ATLAS_BMASK 0x0000FF00
+#define ATLAS_AMASK 0x000000FF
+#else
+#define ATLAS_RMASK 0x000000FF
+#define ATLAS_GMASK 0x0000FF00
+#define ATLAS_BMASK 0x00FF0000
+#define ATLAS_AMASK 0xFF000000
+#endif
+
+static const AtlasGlyph* findGlyph(const GlyphAtlas *atlas, unsigned char c) {
+    if (c < ATLAS_FIRST_GLYPH || c > ATLAS_LAST_GLYPH)
+        c = '?';
+    return &atlas->glyphs[c - ATLAS_FIRST_GLYPH];
+}
+
+int initGlyphAtlas(GlyphAtlas *atlas, TTF_Font *font, SDL_Color color) {
+    SDL_Surface *rendered[ATLAS_NUM_GLYPHS];
+    int ascent = TTF_FontAscent(font);
+    int penX = 0, penY = 0, rowHeight = 0;
+
+    memset(atlas, 0, sizeof(*atlas));
+    atlas->height = TTF_FontHeight(font);
+
+    // First pass: rasterize every glyph once and shelf-pack them into rows.
+    for (int i = 0; i < ATLAS_NUM_GLYPHS; i++) {
+        Uint16 ch = (Uint16)(ATLAS_FIRST_GLYPH + i);
+        AtlasGlyph *g = &atlas->glyphs[i];
+        int minx, maxx, miny, maxy, advance;
+
+        rendered[i] = NULL;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &advance) == -1)
+            continue;
+        g->offsetX = minx;
+        g->offsetY = ascent - maxy;
+        g->advance = advance;
+
+        if (ch == ' ')
+            continue;
+        rendered[i] = TTF_RenderGlyph_Blended(font, ch, color);
+        if (!rendered[i])
+            continue;
+
+        if (penX + rendered[i]->w > ATLAS_WIDTH) {
+            penX = 0;
+            penY += rowHeight + 1;
+            rowHeight = 0;
+        }
+        g->src.x = penX;
+        g->src.y = penY;
+        g->src.w = rendered[i]->w;
+        g->src.h = rendered[i]->h;
+        penX += rendered[i]->w + 1;
+        if (rendered[i]->h > rowHeight)
+            rowHeight = rendered[i]->h;
+    }
+
+    // Second pass: copy the glyph pixels (alpha included) into one surface.
+    atlas->surface = SDL_CreateRGBSurface(SDL_SWSURFACE, ATLAS_WIDTH, penY + rowHeight + 1, 32,
+        ATLAS_RMASK, ATLAS_GMASK, ATLAS_BMASK, ATLAS_AMASK);
+    if (!atlas->surface)
+        fprintf(stderr, "Erreur lors de la creation de l'atlas de glyphes : %s\n", SDL_GetError());
+    else
+        SDL_FillRect(atlas->surface, NULL, SDL_MapRGBA(atlas->surface->format, 0, 0, 0, 0));
+
+    for (int i = 0; i < ATLAS_NUM_GLYPHS; i++) {
+        if (!rendered[i])
+            continue;
+        if (atlas->surface) {
+            SDL_SetAlpha(rendered[i], 0, SDL_ALPHA_OPAQUE);
+            SDL_BlitSurface(rendered[i], NULL, atlas->surface, &atlas->glyphs[i].src);
+        }
+        SDL_FreeSurface(rendered[i]);
+    }
+
+    if (!atlas->surface)
+        return 0;
+    SDL_SetAlpha(atlas->surface, SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+    return 1;
+}
+
+int measureAtlasText(const GlyphAtlas *atlas, const char *text) {
+    int width = 0;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        if ((*p & 0xC0) != 0x80)   // One '?' per UTF-8 character outside the atlas
+            width += findGlyph(atlas, *p)->advance;
+    }
+    return width;
+}
+
+void drawAtlasText(SDL_Surface *screen, const GlyphAtlas *atlas, const char *text, int x, int y) {
+    if (!atlas->surface || !text)
+        return;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        if ((*p & 0xC0) == 0x80)
+            continue;
+        const AtlasGlyph *g = findGlyph(atlas, *p);
+        if (g->src.w > 0) {
+            SDL_Rect src = g->src;
+            SDL_Rect dst = {x + g->offsetX, y + g->offsetY, 0, 0};
+            SDL_BlitSurface(atlas->surface, &src, screen, &dst);
+        }
+        x += g->advance;
+    }
+}
+
+void freeGlyphAtlas(GlyphAtlas *atlas) {
+    if (atlas->surface)
+        SDL_FreeSurface(atlas->surface);
+    atlas->surface = NULL;
+}
@@ -0,0 +1,30 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+
+#define ATLAS_FIRST_GLYPH 32
+#define ATLAS_LAST_GLYPH 126
+#define ATLAS_NUM_GLYPHS (ATLAS_LAST_GLYPH - ATLAS_FIRST_GLYPH + 1)
+#define ATLAS_WIDTH 512
+
+typedef struct {
+    SDL_Rect src;      // Glyph pixels inside the atlas surface (w == 0 for blank glyphs)
+    int offsetX;       // Horizontal bearing from the pen position
+    int offsetY;       // Distance from the top of the line to the top of the glyph
+    int advance;       // Pen advance after drawing this glyph
+} AtlasGlyph;
+
+typedef struct {
+    SDL_Surface *surface;                 // All glyphs packed in rows, rendered once
+    AtlasGlyph glyphs[ATLAS_NUM_GLYPHS];  // Printable ASCII range
+    int height;                           // Font height in pixels
+} GlyphAtlas;
+
+int initGlyphAtlas(GlyphAtlas *atlas, TTF_Font *font, SDL_Color color);
+int measureAtlasText(const GlyphAtlas *atlas, const char *text);
+void drawAtlasText(SDL_Surface *screen, const GlyphAtlas *atlas, const char *text, int x, int y);
+void freeGlyphAtlas(GlyphAtlas *atlas);
+
+#endif // GLYPHATLAS_H
@@ -0,0 +1,59 @@
+#include "gradient.h"
+#include <string.h>
+
+// Blends each 8-bit channel, alpha included.
+Uint32 interpolateColor(Uint32 start, Uint32 end, float ratio) {
+    Uint32 result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        int a = (start >> shift) & 0xFF, b = (end >> shift) & 0xFF;
+        result |= (Uint32)(a + (int)((b - a) * ratio)) << shift;
+    }
+    return result;
+}
+
+void initGradient(Gradient *g, const Uint32 *stops, int stopCount) {
+    memset(g, 0, sizeof(*g));
+    if (stopCount > GRADIENT_MAX_STOPS)
+        stopCount = GRADIENT_MAX_STOPS;
+    memcpy(g->stops, stops, stopCount * sizeof(Uint32));
+    g->stopCount = stopCount;
+}
+
+static void mapGradient(Gradient *g, const SDL_PixelFormat *format) {
+    for (int i = 0; i < GRADIENT_STEPS; i++) {
+        Uint32 rgba = g->stops[0];
+        if (g->stopCount > 1) {
+            float position = (float)i * (g->stopCount - 1) / (GRADIENT_STEPS - 1);
+            int segment = (int)position;
+            if (segment >= g->stopCount - 1)
+                segment = g->stopCount - 2;
+            rgba = interpolateColor(g->stops[segment], g->stops[segment + 1], position - segment);
+        }
+        g->colors[i] = SDL_MapRGB((SDL_PixelFormat *)format, rgba >> 24, (rgba >> 16) & 0xFF, (rgba >> 8) & 0xFF);
+    }
+    g->bpp = format->BitsPerPixel;
+    g->rmask = format->Rmask;
+    g->gmask = format->Gmask;
+    g->bmask = format->Bmask;
+}
+
+Uint32 gradientColor(Gradient *g, SDL_Surface *surface, float ratio) {
+    const SDL_PixelFormat *format = surface->format;
+    if (g->bpp != format->BitsPerPixel || g->rmask != format->Rmask ||
+        g->gmask != format->Gmask || g->bmask != format->Bmask)
+        mapGradient(g, format);
+    int index = (int)(ratio * (GRADIENT_STEPS - 1) + 0.5f);
+    if (index < 0) index = 0;
+    if (index > GRADIENT_STEPS - 1) index = GRADIENT_STEPS - 1;
+    return g->colors[index];
+}
+
+void drawProgressBar(SDL_Surface *surface, Gradient *g, SDL_Rect rect, float ratio, Uint32 trackColor, int inset) {
+    if (ratio < 0) ratio = 0;
+    if (ratio > 1) ratio = 1;
+    SDL_FillRect(surface, &rect, trackColor);
+    int innerW = rect.w - 2 * inset, innerH = rect.h - 2 * inset;
+    SDL_Rect fill = {rect.x + inset, rect.y + inset, (Uint16)(innerW * ratio), (Uint16)innerH};
+    if (innerW > 0 && innerH > 0 && fill.w > 0)
+        SDL_FillRect(surface, &fill, gradientColor(g, surface, ratio));
+}
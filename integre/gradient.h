@@ -0,0 +1,31 @@
+#ifndef GRADIENT_H
+#define GRADIENT_H
+
+#include <SDL/SDL.h>
+
+#define GRADIENT_STEPS 256
+#define GRADIENT_MAX_STOPS 8
+
+// Colour ramp for progress bars: the stops are blended once into a table of
+// pixel values in the target surface's format, so drawing a bar is a lookup
+// and a rectangle fill.
+typedef struct {
+    Uint32 stops[GRADIENT_MAX_STOPS];   // 0xRRGGBBAA, evenly spaced from ratio 0 to 1
+    int stopCount;
+    Uint32 colors[GRADIENT_STEPS];      // Mapped pixel values
+    Uint8 bpp;                          // Format colors was mapped for, 0 = not yet
+    Uint32 rmask, gmask, bmask;
+} Gradient;
+
+// Colours are 0xRRGGBBAA, as SDL_gfx takes them; ratio is 0..1. The
+// gradient table is built with it.
+Uint32 interpolateColor(Uint32 start, Uint32 end, float ratio);
+void initGradient(Gradient *g, const Uint32 *stops, int stopCount);
+// Pixel value for ratio (0..1) in surface's format; remaps the table if the
+// format changed since the last call.
+Uint32 gradientColor(Gradient *g, SDL_Surface *surface, float ratio);
+// Fills rect with trackColor (a pixel value), then the first ratio of it,
+// inset by `inset` pixels, with the gradient colour for ratio.
+void drawProgressBar(SDL_Surface *surface, Gradient *g, SDL_Rect rect, float ratio, Uint32 trackColor, int inset);
+
+#endif // GRADIENT_H
@@ -6,13 +6,15 @@
 #include <SDL/SDL_mixer.h>
 #include <SDL/SDL_ttf.h>
 #include <stdio.h>
+#include "strpool.h"
 
 #define NUM_BUTTONS 5
 #define NO_HOVER 999
-#define MAX_QUESTIONS 10
-#define MAX_QUESTION_LENGTH 256
-#define MAX_ANSWER_LENGTH 100
+#define QUIZ_ROUND_QUESTIONS 10   // Questions asked per quiz round
 #define TOTAL_QUIZ_TIME 60
+#define TOTAL_QUIZ_US ((Uint64)TOTAL_QUIZ_TIME * 1000000)
+#define TIMER_SUBPIXELS 16        // Steps of the bar's partly covered edge column
+#define FAST_ANSWER_MS 5000      // Answers quicker than this earn a bonus
 
 typedef struct {
     SDL_Rect rect;
@@ -22,36 +24,37 @@ typedef struct {
 } ButtonImg;
 
 typedef struct {
-    char question[MAX_QUESTION_LENGTH];
-    char answers[3][MAX_ANSWER_LENGTH];
+    StringView question;   // UTF-8, owned by the question bank
+    StringView answers[3];
     int correctAnswer;
-    int used;
+    int id;                // In the question bank (qbank.h)
+    int category;
+    int difficulty;
 } Question;
 
 typedef struct {
     int score;
     int lives;
     int level;
-    int timeLeft;
-    Uint32 startTime;
+    int timeLeft;          // Whole seconds, rounded up
+    Uint64 timeLeftUs;
+    Uint64 startUs;        // gameClockUs() when the question appeared
 } GameState;
 
 typedef struct {
-    SDL_Surface* fullTimer;
-    SDL_Surface* currentTimer;
+    SDL_Surface* strip;        // The bar flattened on its track, screen format
     SDL_Rect position;
-    SDL_Rect cropRect;
     int maxWidth;
+    int level;                 // Filled width in 1/TIMER_SUBPIXELS pixels
+    Uint32 trackColor;
 } TimerBar;
 
-int getHoveredButtonAt(ButtonImg buttons[], int numButtons, int mouseX, int mouseY);
 void initialiser_bouton(ButtonImg *btn, const char *chemin, int x, int y, const char* text, TTF_Font* font);
-void updateAnswerButtons(ButtonImg normalButtons[], ButtonImg hoveredButtons[], const char answers[][MAX_ANSWER_LENGTH], TTF_Font* font);
-int loadQuestions(Question questions[], const char* filename);
-Question* getRandomQuestion(Question questions[]);
-int checkAnswer(Question* q, int answerIndex, GameState* state);
+void updateAnswerButtons(ButtonImg normalButtons[], ButtonImg hoveredButtons[], const StringView answers[3], TTF_Font* font);
+int checkAnswer(Question* q, int answerIndex, GameState* state, Uint64 responseUs);
 void initTimerBar(TimerBar* timer, const char* imagePath, int x, int y, SDL_Surface* screen);
-void updateTimerBar(TimerBar* timer, float timeRatio, SDL_Surface* screen);
+int updateTimerBar(TimerBar* timer, float timeRatio, SDL_Rect* changed);
+Uint32 timerBarNextChangeMs(const TimerBar* timer, Uint64 timeLeftUs, Uint64 totalUs);
 void renderTimerBar(SDL_Surface* screen, TimerBar* timer);
 void freeTimerBar(TimerBar* timer);
 void updateGameState(GameState* state);
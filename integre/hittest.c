@@ -0,0 +1,143 @@
+#include "hittest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Edges are inclusive, as in the original rectangle tests.
+static int containsPoint(SDL_Rect r, int x, int y) {
+    return x >= r.x && x <= r.x + r.w && y >= r.y && y <= r.y + r.h;
+}
+
+int hitTestGrid(const HitGrid *grid, int x, int y) {
+    int localX = x - grid->originX, localY = y - grid->originY;
+    if (localX < 0 || localY < 0)
+        return NO_HIT;
+    int col = localX / grid->pitchX, row = localY / grid->pitchY;
+    if (col >= grid->cols || row >= grid->rows)
+        return NO_HIT;
+    // Points in the spacing between cells hit nothing.
+    if (localX - col * grid->pitchX > grid->cellW || localY - row * grid->pitchY > grid->cellH)
+        return NO_HIT;
+    return row * grid->cols + col;
+}
+
+void initHitIndex(HitIndex *index, int width, int height, int cellSize) {
+    memset(index, 0, sizeof(*index));
+    index->cellSize = cellSize;
+    index->cols = (width + cellSize - 1) / cellSize;
+    index->rows = (height + cellSize - 1) / cellSize;
+    index->cellStart = calloc(index->cols * index->rows + 1, sizeof(int));
+    index->dirty = 1;
+}
+
+int addHitWidget(HitIndex *index, int id, SDL_Rect rect, int z) {
+    if (index->count >= MAX_HIT_WIDGETS) {
+        fprintf(stderr, "Erreur : trop de zones cliquables (%d)\n", id);
+        return NO_HIT;
+    }
+    HitWidget *w = &index->widgets[index->count];
+    w->rect = rect;
+    w->id = id;
+    w->z = z;
+    w->enabled = 1;
+    index->dirty = 1;
+    return index->count++;
+}
+
+void setHitWidgetEnabled(HitIndex *index, int id, int enabled) {
+    for (int i = 0; i < index->count; i++) {
+        if (index->widgets[i].id == id)
+            index->widgets[i].enabled = enabled;
+    }
+}
+
+void setHitRangeEnabled(HitIndex *index, int firstId, int lastId, int enabled) {
+    for (int i = 0; i < index->count; i++) {
+        if (index->widgets[i].id >= firstId && index->widgets[i].id <= lastId)
+            index->widgets[i].enabled = enabled;
+    }
+}
+
+// Cell range covered by a widget, clamped to the index.
+static void cellSpan(const HitIndex *index, SDL_Rect r, int *c0, int *r0, int *c1, int *r1) {
+    *c0 = r.x / index->cellSize;
+    *r0 = r.y / index->cellSize;
+    *c1 = (r.x + r.w) / index->cellSize;
+    *r1 = (r.y + r.h) / index->cellSize;
+    if (*c0 < 0) *c0 = 0;
+    if (*r0 < 0) *r0 = 0;
+    if (*c1 >= index->cols) *c1 = index->cols - 1;
+    if (*r1 >= index->rows) *r1 = index->rows - 1;
+}
+
+static void rebuildBuckets(HitIndex *index) {
+    int cells = index->cols * index->rows;
+    int *fill = calloc(cells, sizeof(int));
+    memset(index->cellStart, 0, (cells + 1) * sizeof(int));
+
+    // Count, prefix-sum, then scatter (compressed rows).
+    for (int i = 0; i < index->count; i++) {
+        int c0, r0, c1, r1;
+        cellSpan(index, index->widgets[i].rect, &c0, &r0, &c1, &r1);
+        for (int row = r0; row <= r1; row++)
+            for (int col = c0; col <= c1; col++)
+                index->cellStart[row * index->cols + col + 1]++;
+    }
+    for (int c = 0; c < cells; c++)
+        index->cellStart[c + 1] += index->cellStart[c];
+    free(index->cellItems);
+    index->cellItems = malloc(index->cellStart[cells] ? index->cellStart[cells] : 1);
+    for (int i = 0; i < index->count; i++) {
+        int c0, r0, c1, r1;
+        cellSpan(index, index->widgets[i].rect, &c0, &r0, &c1, &r1);
+        for (int row = r0; row <= r1; row++) {
+            for (int col = c0; col <= c1; col++) {
+                int cell = row * index->cols + col;
+                index->cellItems[index->cellStart[cell] + fill[cell]++] = (Uint8)i;
+            }
+        }
+    }
+
+    // Insertion sort each bucket by z; buckets hold a handful of widgets.
+    for (int c = 0; c < cells; c++) {
+        Uint8 *items = index->cellItems + index->cellStart[c];
+        int n = index->cellStart[c + 1] - index->cellStart[c];
+        for (int i = 1; i < n; i++) {
+            Uint8 item = items[i];
+            int j = i - 1;
+            while (j >= 0 && index->widgets[items[j]].z < index->widgets[item].z) {
+                items[j + 1] = items[j];
+                j--;
+            }
+            items[j + 1] = item;
+        }
+    }
+    free(fill);
+    index->dirty = 0;
+}
+
+// Returns the id of the top-most enabled widget under (x, y), or NO_HIT.
+int hitTest(HitIndex *index, int x, int y) {
+    if (x < 0 || y < 0 || !index->cellStart)
+        return NO_HIT;
+    int col = x / index->cellSize, row = y / index->cellSize;
+    if (col >= index->cols || row >= index->rows)
+        return NO_HIT;
+    if (index->dirty)
+        rebuildBuckets(index);
+
+    int cell = row * index->cols + col;
+    for (int k = index->cellStart[cell]; k < index->cellStart[cell + 1]; k++) {
+        const HitWidget *w = &index->widgets[index->cellItems[k]];
+        if (w->enabled && containsPoint(w->rect, x, y))
+            return w->id;
+    }
+    return NO_HIT;
+}
+
+void freeHitIndex(HitIndex *index) {
+    free(index->cellStart);
+    free(index->cellItems);
+    index->cellStart = NULL;
+    index->cellItems = NULL;
+}
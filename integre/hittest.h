@@ -0,0 +1,48 @@
+#ifndef HITTEST_H
+#define HITTEST_H
+
+#include <SDL/SDL.h>
+
+#define NO_HIT -1
+#define HIT_CELL_SIZE 64
+#define MAX_HIT_WIDGETS 64
+
+// Uniform grid of equal cells separated by gaps (memory boards): the cell
+// under a point is computed directly, no search.
+typedef struct {
+    int originX, originY;
+    int cols, rows;
+    int cellW, cellH;
+    int pitchX, pitchY;    // Cell size plus spacing
+} HitGrid;
+
+typedef struct {
+    SDL_Rect rect;
+    int id;
+    int z;                 // Higher is drawn on top and wins overlapping hits
+    int enabled;
+} HitWidget;
+
+// Arbitrary rectangles bucketed into a coarse uniform grid. Each bucket
+// lists its widgets by descending z, so the first enabled one that
+// contains the point is the top-most hit.
+typedef struct {
+    HitWidget widgets[MAX_HIT_WIDGETS];
+    int count;
+    int cellSize;
+    int cols, rows;
+    int *cellStart;        // cols*rows+1 offsets into cellItems
+    Uint8 *cellItems;      // Widget slots per cell
+    int dirty;             // Buckets rebuilt on the next query
+} HitIndex;
+
+int hitTestGrid(const HitGrid *grid, int x, int y);
+
+void initHitIndex(HitIndex *index, int width, int height, int cellSize);
+int addHitWidget(HitIndex *index, int id, SDL_Rect rect, int z);
+void setHitWidgetEnabled(HitIndex *index, int id, int enabled);
+void setHitRangeEnabled(HitIndex *index, int firstId, int lastId, int enabled);
+int hitTest(HitIndex *index, int x, int y);
+void freeHitIndex(HitIndex *index);
+
+#endif // HITTEST_H
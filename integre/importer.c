@@ -0,0 +1,468 @@
+#include "importer.h"
+#include "strpool.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FILE_MAX_CATEGORIES 1024
+
+typedef struct {
+    Uint32 question;           // Offsets in the file's own pool
+    Uint32 answers[3];
+    Uint16 category;           // Index in the file's own categories
+    Uint16 difficulty;
+    Uint32 line;
+    Uint64 hash;               // Of the normalized question
+} ParsedQuestion;
+
+typedef struct {
+    ImportFileReport *report;
+    StringPool pool;
+    ParsedQuestion *questions;
+    Uint32 count;
+    Uint32 capacity;
+    Uint32 categories[FILE_MAX_CATEGORIES];
+    int categoryCount;
+} ParsedFile;
+
+typedef struct {
+    ParsedFile *files;
+    int count;
+    int next;
+    SDL_mutex *lock;
+} ImportJob;
+
+// Sized with a first pass, so long paths or messages are never cut short.
+static void reportProblem(ImportFileReport *r, int line, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int detail = vsnprintf(NULL, 0, format, args);
+    va_end(args);
+    int prefix = snprintf(NULL, 0, "%s:%d: ", r->path, line);
+    if (detail < 0 || prefix < 0)
+        return;
+
+    size_t length = (size_t)prefix + detail + 1;   // With the newline
+    char *grown = realloc(r->messages, r->messagesLength + length + 1);
+    if (!grown)
+        return;
+    char *message = grown + r->messagesLength;
+    snprintf(message, prefix + 1, "%s:%d: ", r->path, line);
+    va_start(args, format);
+    vsnprintf(message + prefix, detail + 1, format, args);
+    va_end(args);
+    message[length - 1] = '\n';
+    message[length] = '\0';
+    r->messages = grown;
+    r->messagesLength += length;
+}
+
+// Letters and digits only, lowercased; any run of other ASCII characters
+// becomes one space. "Who wrote  Dune?" and "who wrote dune" match.
+static char* normalize(StringView view) {
+    char *out = malloc(view.length + 1);
+    if (!out)
+        return NULL;
+    size_t n = 0;
+    for (Uint32 i = 0; i < view.length; i++) {
+        unsigned char c = (unsigned char)view.text[i];
+        if (c >= 0x80 || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z')) {
+            out[n++] = (char)c;
+        } else if (c >= 'A' && c <= 'Z') {
+            out[n++] = (char)(c - 'A' + 'a');
+        } else if (n > 0 && out[n - 1] != ' ') {
+            out[n++] = ' ';
+        }
+    }
+    if (n > 0 && out[n - 1] == ' ')
+        n--;
+    out[n] = '\0';
+    return out;
+}
+
+static Uint64 hashText(const char *text) {
+    Uint64 h = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        h ^= *p;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static StringView fileString(const ParsedFile *f, Uint32 offset) {
+    return poolString(f->pool.data, f->pool.size, offset);
+}
+
+static int addFileCategory(ParsedFile *f, long offset) {
+    if (offset < 0)
+        return -1;
+    for (int i = 0; i < f->categoryCount; i++) {
+        if (f->categories[i] == (Uint32)offset)
+            return i;
+    }
+    if (f->categoryCount == FILE_MAX_CATEGORIES)
+        return -1;
+    f->categories[f->categoryCount] = (Uint32)offset;
+    return f->categoryCount++;
+}
+
+static int addQuestion(ParsedFile *f, const ParsedQuestion *q) {
+    if (f->count == f->capacity) {
+        Uint32 capacity = f->capacity ? f->capacity * 2 : 256;
+        ParsedQuestion *grown = realloc(f->questions, capacity * sizeof(ParsedQuestion));
+        if (!grown)
+            return 0;
+        f->questions = grown;
+        f->capacity = capacity;
+    }
+    f->questions[f->count++] = *q;
+    return 1;
+}
+
+// Four interned lines make a question; anything wrong with them drops it.
+static void finishQuestion(ParsedFile *f, const Uint32 parts[4], int category, int difficulty, int line) {
+    ImportFileReport *r = f->report;
+    if (parts[1] == parts[2] || parts[1] == parts[3] || parts[2] == parts[3]) {
+        reportProblem(r, line, "la meme reponse apparait deux fois");
+        r->errors++;
+        return;
+    }
+    ParsedQuestion q = {parts[0], {parts[1], parts[2], parts[3]}, (Uint16)category, (Uint16)difficulty,
+                        (Uint32)line, 0};
+    char *normalized = normalize(fileString(f, parts[0]));
+    if (!normalized || !normalized[0]) {
+        reportProblem(r, line, normalized ? "question sans lettres ni chiffres" : "memoire insuffisante");
+        r->errors++;
+        free(normalized);
+        return;
+    }
+    q.hash = hashText(normalized);
+    free(normalized);
+    if (!addQuestion(f, &q)) {
+        reportProblem(r, line, "memoire insuffisante");
+        r->errors++;
+    }
+}
+
+static void parseFile(ParsedFile *f) {
+    ImportFileReport *r = f->report;
+    Uint32 start = SDL_GetTicks();
+    FILE *fp = fopen(r->path, "rb");
+    if (!fp) {
+        reportProblem(r, 0, "impossible d'ouvrir le fichier");
+        r->errors++;
+        return;
+    }
+
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+    int lineNumber = 0, category = -1, difficulty = 1;
+    int have = 0, firstLine = 0, broken = 0;
+    Uint32 parts[4];
+
+    while ((length = getline(&line, &capacity, fp)) >= 0) {
+        lineNumber++;
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r'))
+            line[--length] = '\0';
+
+        // A blank or category line ends the question being read.
+        if (line[0] == '\0' || line[0] == '[') {
+            if (have) {
+                reportProblem(r, firstLine, "question incomplete (%d reponse(s) sur 3)", have - 1);
+                r->errors++;
+                have = 0;
+                broken = 0;
+            }
+            if (line[0] == '\0')
+                continue;
+            char *close = strchr(line, ']');
+            if (!close || !isValidUtf8(line, length)) {
+                reportProblem(r, lineNumber, close ? "categorie pas en UTF-8" : "categorie sans ']'");
+                r->errors++;
+                continue;
+            }
+            *close = '\0';
+            difficulty = (int)strtol(close + 1, NULL, 10);
+            if (difficulty < 1)
+                difficulty = 1;
+            category = addFileCategory(f, internString(&f->pool, line + 1, strlen(line + 1)));
+            if (category < 0) {
+                reportProblem(r, lineNumber, "trop de categories");
+                r->errors++;
+            }
+            continue;
+        }
+
+        if (!have)
+            firstLine = lineNumber;
+        long offset = -1;
+        if (!isValidUtf8(line, length)) {
+            reportProblem(r, lineNumber, "texte pas en UTF-8");
+            broken = 1;
+        } else {
+            offset = internString(&f->pool, line, length);
+        }
+        broken = broken || offset < 0;
+        parts[have++] = (Uint32)offset;
+        if (have < 4)
+            continue;
+
+        if (broken) {
+            r->errors++;
+        } else {
+            if (category < 0)
+                category = addFileCategory(f, internString(&f->pool, "General", 7));
+            if (category >= 0)
+                finishQuestion(f, parts, category, difficulty, firstLine);
+        }
+        have = 0;
+        broken = 0;
+    }
+    if (have) {
+        reportProblem(r, firstLine, "question incomplete en fin de fichier (%d reponse(s) sur 3)", have - 1);
+        r->errors++;
+    }
+    free(line);
+    fclose(fp);
+    r->parseMs = SDL_GetTicks() - start;
+}
+
+static int importWorker(void *data) {
+    ImportJob *job = data;
+    for (;;) {
+        SDL_mutexP(job->lock);
+        int index = job->next++;
+        SDL_mutexV(job->lock);
+        if (index >= job->count)
+            return 0;
+        parseFile(&job->files[index]);
+    }
+}
+
+typedef struct {
+    Uint64 hash;
+    Uint32 record;             // Index + 1, 0 when the slot is empty
+} SeenSlot;
+
+typedef struct {
+    StringPool pool;
+    QBankRecord *records;
+    Uint32 *origins;           // File index and line of each record, for reports
+    Uint32 *originLines;
+    Uint32 count;
+    Uint32 capacity;
+    Uint32 categories[QBANK_MAX_CATEGORIES];
+    Uint32 categoryCount;
+    SeenSlot *seen;
+    Uint32 seenSlots;
+} Merge;
+
+static int growMerge(Merge *m) {
+    Uint32 capacity = m->capacity ? m->capacity * 2 : 1024;
+    QBankRecord *records = realloc(m->records, capacity * sizeof(QBankRecord));
+    if (records)
+        m->records = records;
+    Uint32 *origins = realloc(m->origins, capacity * sizeof(Uint32));
+    if (origins)
+        m->origins = origins;
+    Uint32 *lines = realloc(m->originLines, capacity * sizeof(Uint32));
+    if (lines)
+        m->originLines = lines;
+    if (!records || !origins || !lines)
+        return 0;
+    m->capacity = capacity;
+
+    // The duplicate table stays at most half full.
+    SeenSlot *seen = calloc(capacity * 2, sizeof(SeenSlot));
+    if (!seen)
+        return 0;
+    for (Uint32 i = 0; i < m->seenSlots; i++) {
+        if (!m->seen[i].record)
+            continue;
+        Uint32 j = (Uint32)m->seen[i].hash & (capacity * 2 - 1);
+        while (seen[j].record)
+            j = (j + 1) & (capacity * 2 - 1);
+        seen[j] = m->seen[i];
+    }
+    free(m->seen);
+    m->seen = seen;
+    m->seenSlots = capacity * 2;
+    return 1;
+}
+
+// Index of the earlier record asking the same question, or -1.
+static long findDuplicate(const Merge *m, Uint64 hash, StringView question, Uint32 *slot) {
+    Uint32 mask = m->seenSlots - 1;
+    char *normalized = NULL;
+    Uint32 i = (Uint32)hash & mask;
+    long found = -1;
+    for (; m->seen[i].record && found < 0; i = (i + 1) & mask) {
+        if (m->seen[i].hash != hash)
+            continue;
+        // Same hash: compare the text to rule out a collision.
+        Uint32 record = m->seen[i].record - 1;
+        if (!normalized)
+            normalized = normalize(question);
+        char *other = normalize(poolString(m->pool.data, m->pool.size, m->records[record].question));
+        if (normalized && other && strcmp(normalized, other) == 0)
+            found = record;
+        free(other);
+    }
+    free(normalized);
+    *slot = i;
+    return found;
+}
+
+static int mergeFile(Merge *m, ParsedFile *f, int fileIndex, const char *const *paths) {
+    ImportFileReport *r = f->report;
+    Uint16 categoryMap[FILE_MAX_CATEGORIES];
+    for (int c = 0; c < f->categoryCount; c++) {
+        StringView name = fileString(f, f->categories[c]);
+        long offset = internString(&m->pool, name.text, name.length);
+        if (offset < 0)
+            return 0;
+        Uint32 g = 0;
+        while (g < m->categoryCount && m->categories[g] != (Uint32)offset)
+            g++;
+        if (g == m->categoryCount) {
+            if (m->categoryCount == QBANK_MAX_CATEGORIES)
+                return 0;
+            m->categories[m->categoryCount++] = (Uint32)offset;
+        }
+        categoryMap[c] = (Uint16)g;
+    }
+
+    for (Uint32 i = 0; i < f->count; i++) {
+        const ParsedQuestion *q = &f->questions[i];
+        if (m->count == m->capacity && !growMerge(m))
+            return 0;
+        Uint32 slot;
+        long earlier = findDuplicate(m, q->hash, fileString(f, q->question), &slot);
+        if (earlier >= 0) {
+            reportProblem(r, q->line, "doublon de %s:%u", paths[m->origins[earlier]], m->originLines[earlier]);
+            r->duplicates++;
+            continue;
+        }
+
+        QBankRecord record;
+        const Uint32 *offsets[4] = {&q->question, &q->answers[0], &q->answers[1], &q->answers[2]};
+        Uint32 *targets[4] = {&record.question, &record.answers[0], &record.answers[1], &record.answers[2]};
+        for (int k = 0; k < 4; k++) {
+            StringView text = fileString(f, *offsets[k]);
+            long offset = internString(&m->pool, text.text, text.length);
+            if (offset < 0)
+                return 0;
+            *targets[k] = (Uint32)offset;
+        }
+        record.category = categoryMap[q->category];
+        record.difficulty = q->difficulty;
+        m->records[m->count] = record;
+        m->origins[m->count] = (Uint32)fileIndex;
+        m->originLines[m->count] = q->line;
+        m->seen[slot].hash = q->hash;
+        m->seen[slot].record = ++m->count;
+        r->questions++;
+    }
+    return 1;
+}
+
+int importQuestionFiles(const char *const *paths, int count, int threads,
+                        QuestionBank *bank, ImportReport *report) {
+    memset(bank, 0, sizeof(*bank));
+    memset(report, 0, sizeof(*report));
+    if (count <= 0)
+        return 0;
+    report->files = calloc(count, sizeof(ImportFileReport));
+    ParsedFile *files = calloc(count, sizeof(ParsedFile));
+    Merge *m = calloc(1, sizeof(Merge));
+    if (!report->files || !files || !m) {
+        free(files);
+        free(m);
+        freeImportReport(report);
+        return 0;
+    }
+    report->fileCount = count;
+    for (int i = 0; i < count; i++) {
+        report->files[i].path = paths[i];
+        files[i].report = &report->files[i];
+        initStringPool(&files[i].pool);
+    }
+
+    // Parse: one file per task. The calling thread is one of the workers.
+    if (threads > count)
+        threads = count;
+    if (threads > IMPORT_MAX_THREADS)
+        threads = IMPORT_MAX_THREADS;
+    if (threads < 1)
+        threads = 1;
+    Uint32 start = SDL_GetTicks();
+    ImportJob job = {files, count, 0, SDL_CreateMutex()};
+    SDL_Thread *workers[IMPORT_MAX_THREADS] = {NULL};
+    report->threads = 1;
+    for (int t = 0; job.lock && t < threads - 1; t++) {
+        workers[t] = SDL_CreateThread(importWorker, &job);
+        if (workers[t])
+            report->threads++;
+    }
+    importWorker(&job);   // Does it all if no thread could be started
+    for (int t = 0; t < threads - 1; t++) {
+        if (workers[t])
+            SDL_WaitThread(workers[t], NULL);
+    }
+    if (job.lock)
+        SDL_DestroyMutex(job.lock);
+    report->parseMs = SDL_GetTicks() - start;
+
+    // Merge in file order, so the result does not depend on scheduling.
+    start = SDL_GetTicks();
+    initStringPool(&m->pool);
+    int ok = 1;
+    for (int i = 0; i < count; i++) {
+        if (ok && !mergeFile(m, &files[i], i, paths)) {
+            reportProblem(&report->files[i], 0, "memoire insuffisante, import interrompu");
+            report->files[i].errors++;
+            ok = 0;
+        }
+        freeStringPool(&files[i].pool);
+        free(files[i].questions);
+    }
+    ok = ok && buildQuestionBank(bank, &m->pool, m->records, m->count, m->categories, m->categoryCount);
+    report->mergeMs = SDL_GetTicks() - start;
+
+    for (int i = 0; i < count; i++) {
+        report->questions += report->files[i].questions;
+        report->duplicates += report->files[i].duplicates;
+        report->errors += report->files[i].errors;
+    }
+    freeStringPool(&m->pool);
+    free(m->records);
+    free(m->origins);
+    free(m->originLines);
+    free(m->seen);
+    free(m);
+    free(files);
+    return ok;
+}
+
+void printImportReport(const ImportReport *report, FILE *out) {
+    fprintf(out, "%-32s %9s %10s %7s %8s\n", "file", "questions", "duplicates", "errors", "parse ms");
+    for (int i = 0; i < report->fileCount; i++) {
+        const ImportFileReport *f = &report->files[i];
+        fprintf(out, "%-32s %9d %10d %7d %8u\n", f->path, f->questions, f->duplicates, f->errors, f->parseMs);
+    }
+    fprintf(out, "%-32s %9d %10d %7d\n", "total", report->questions, report->duplicates, report->errors);
+    fprintf(out, "Parsed on %d thread(s) in %u ms, merged in %u ms\n", report->threads,
+            report->parseMs, report->mergeMs);
+    for (int i = 0; i < report->fileCount; i++) {
+        if (report->files[i].messages)
+            fputs(report->files[i].messages, out);
+    }
+}
+
+void freeImportReport(ImportReport *report) {
+    for (int i = 0; report->files && i < report->fileCount; i++)
+        free(report->files[i].messages);
+    free(report->files);
+    memset(report, 0, sizeof(*report));
+}
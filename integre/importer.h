@@ -0,0 +1,41 @@
+#ifndef IMPORTER_H
+#define IMPORTER_H
+
+#include "qbank.h"
+#include <stdio.h>
+
+#define IMPORT_MAX_THREADS 32
+
+typedef struct {
+    const char *path;
+    int questions;             // Accepted into the bank
+    int duplicates;            // Dropped: same question seen earlier
+    int errors;                // Dropped: malformed or not UTF-8
+    char *messages;            // One "path:line: ..." line per problem
+    size_t messagesLength;
+    Uint32 parseMs;
+} ImportFileReport;
+
+typedef struct {
+    ImportFileReport *files;
+    int fileCount;
+    int questions;
+    int duplicates;
+    int errors;
+    int threads;
+    Uint32 parseMs;            // Wall time of the parallel parse
+    Uint32 mergeMs;
+} ImportReport;
+
+// Strict counterpart of compileQuestionText() for content imports: parses
+// the files (qbank.h text format) on up to `threads` threads, rejects
+// questions with missing or empty answers and text that is not UTF-8, and
+// keeps only the first copy of a question asked twice (compared ignoring
+// case, spacing and punctuation). Questions keep file order whatever the
+// thread count. Returns 0 when no question survived.
+int importQuestionFiles(const char *const *paths, int count, int threads,
+                        QuestionBank *bank, ImportReport *report);
+void printImportReport(const ImportReport *report, FILE *out);
+void freeImportReport(ImportReport *report);
+
+#endif // IMPORTER_H
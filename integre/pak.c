@@ -0,0 +1,143 @@
+#include "pak.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const Uint8 *pakBase = NULL;
+static size_t pakSize = 0;
+static const PakEntry *pakEntries = NULL;
+static int pakCount = 0;
+
+static const char* stripDot(const char *path) {
+    while (path[0] == '.' && path[1] == '/')
+        path += 2;
+    return path;
+}
+
+static int compareEntry(const void *key, const void *entry) {
+    return strncmp(key, ((const PakEntry *)entry)->name, PAK_NAME_LENGTH);
+}
+
+static const PakEntry* findEntry(const char *path) {
+    if (!pakCount)
+        return NULL;
+    return bsearch(stripDot(path), pakEntries, pakCount, sizeof(PakEntry), compareEntry);
+}
+
+static const void* mapFile(const char *path, size_t *size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // The mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        fprintf(stderr, "Erreur : impossible de projeter %s\n", path);
+        return NULL;
+    }
+    *size = st.st_size;
+    return base;
+}
+
+int openPak(const char *path) {
+    closePak();
+    size_t size;
+    const Uint8 *base = mapFile(path, &size);
+    if (!base)
+        return 0;
+
+    const PakHeader *hdr = (const PakHeader *)base;
+    int valid = size >= sizeof(PakHeader) && hdr->magic == PAK_MAGIC && hdr->version == PAK_VERSION;
+    size_t tableEnd = valid ? sizeof(PakHeader) + (size_t)hdr->count * sizeof(PakEntry) : 0;
+    valid = valid && tableEnd <= size;
+    const PakEntry *entries = (const PakEntry *)(hdr + 1);
+    for (Uint32 i = 0; valid && i < hdr->count; i++) {
+        valid = entries[i].name[PAK_NAME_LENGTH - 1] == '\0' &&
+                entries[i].offset >= tableEnd &&
+                (size_t)entries[i].offset + entries[i].size <= size;
+    }
+    if (!valid) {
+        fprintf(stderr, "Erreur : archive %s invalide\n", path);
+        munmap((void *)base, size);
+        return 0;
+    }
+
+    pakBase = base;
+    pakSize = size;
+    pakEntries = entries;
+    pakCount = hdr->count;
+    return pakCount;
+}
+
+const void* findPakFile(const char *path, Uint32 *size) {
+    const PakEntry *e = findEntry(path);
+    if (!e)
+        return NULL;
+    if (size)
+        *size = e->size;
+    return pakBase + e->offset;
+}
+
+SDL_RWops* openAssetRW(const char *path) {
+    Uint32 size;
+    const void *data = findPakFile(path, &size);
+    if (data)
+        return SDL_RWFromConstMem(data, size);
+    return SDL_RWFromFile(path, "rb");
+}
+
+FILE* openAssetFile(const char *path) {
+    Uint32 size;
+    const void *data = findPakFile(path, &size);
+    if (data && size > 0)
+        return fmemopen((void *)data, size, "rb");
+    return fopen(path, "rb");
+}
+
+const void* mapAsset(const char *path, size_t *size) {
+    Uint32 packedSize;
+    const void *data = findPakFile(path, &packedSize);
+    if (data) {
+        *size = packedSize;
+        return data;
+    }
+    return mapFile(path, size);
+}
+
+void unmapAsset(const void *data, size_t size) {
+    const Uint8 *p = data;
+    if (p && !(p >= pakBase && p < pakBase + pakSize))
+        munmap((void *)p, size);
+}
+
+long assetMtime(const char *path) {
+    const PakEntry *e = findEntry(path);
+    if (e)
+        return (long)e->mtime;
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_mtime : -1;
+}
+
+long assetSize(const char *path) {
+    const PakEntry *e = findEntry(path);
+    if (e)
+        return e->size;
+    struct stat st;
+    return stat(path, &st) == 0 ? (long)st.st_size : -1;
+}
+
+void closePak(void) {
+    if (pakBase)
+        munmap((void *)pakBase, pakSize);
+    pakBase = NULL;
+    pakSize = 0;
+    pakEntries = NULL;
+    pakCount = 0;
+}
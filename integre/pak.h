@@ -0,0 +1,45 @@
+#ifndef PAK_H
+#define PAK_H
+
+#include <SDL/SDL.h>
+#include <stdio.h>
+
+#define PAK_FILE "assets.pak"
+#define PAK_MAGIC 0x4B415051  // "QPAK"
+#define PAK_VERSION 1
+#define PAK_NAME_LENGTH 64
+#define PAK_ALIGN 16          // Each file's data starts on this boundary
+
+// File layout written by tools/pack_assets.c: a header, the entries sorted
+// by name, then the file contents at the recorded offsets.
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 count;
+} PakHeader;
+
+typedef struct {
+    char name[PAK_NAME_LENGTH];   // Relative path, without a leading "./"
+    Uint32 offset;                // From the start of the archive
+    Uint32 size;
+    Sint64 mtime;                 // Of the source file, for the tile cache
+} PakEntry;
+
+// One archive per process, mapped read-only. Returns the number of files,
+// 0 if the archive is missing or invalid (everything then comes from disk).
+int openPak(const char *path);
+const void* findPakFile(const char *path, Uint32 *size);
+// Open a game file from the archive when it is packed, from disk otherwise.
+// Archive reads are zero-copy: the data stays in the mapping, so anything
+// that keeps reading lazily (fonts) must be closed before closePak().
+SDL_RWops* openAssetRW(const char *path);
+FILE* openAssetFile(const char *path);
+// Whole file, read-only: from the archive, else mapped from disk.
+const void* mapAsset(const char *path, size_t *size);
+void unmapAsset(const void *data, size_t size);
+// Source modification time, -1 when the file exists nowhere.
+long assetMtime(const char *path);
+long assetSize(const char *path);
+void closePak(void);
+
+#endif // PAK_H
@@ -0,0 +1,206 @@
+#include "preload.h"
+#include "assets.h"
+#include "pak.h"
+#include "baked.h"
+#include <stdio.h>
+#include <string.h>
+
+static void* decodeItem(PreloadItem *item) {
+    SDL_Surface *baked;
+    switch (item->type) {
+    case PRELOAD_IMAGE:
+    case PRELOAD_DECODED_IMAGE:
+        return IMG_Load_RW(openAssetRW(item->path), 1);
+    case PRELOAD_OPAQUE_IMAGE:
+        baked = loadBakedImage(item->path, 0, 0);
+        return baked ? baked : IMG_Load_RW(openAssetRW(item->path), 1);
+    case PRELOAD_STRETCHED_IMAGE: {
+        // Baked at the stretched size: no decode and no stretch.
+        baked = loadBakedImage(item->path, item->w, item->h);
+        if (baked)
+            return baked;
+        SDL_Surface *original = IMG_Load_RW(openAssetRW(item->path), 1);
+        if (!original)
+            return NULL;
+        // SDL_SoftStretch needs both surfaces in the same pixel format.
+        SDL_PixelFormat *fmt = original->format;
+        SDL_Surface *stretched = SDL_CreateRGBSurface(SDL_SWSURFACE, item->w, item->h, fmt->BitsPerPixel,
+                                                      fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask);
+        if (stretched && SDL_SoftStretch(original, NULL, stretched, NULL) < 0) {
+            SDL_FreeSurface(stretched);
+            stretched = NULL;
+        }
+        SDL_FreeSurface(original);
+        return stretched;
+    }
+    case PRELOAD_SOUND:
+        return Mix_LoadWAV_RW(openAssetRW(item->path), 1);
+    case PRELOAD_MUSIC:
+        return Mix_LoadMUS(item->path);   // Streamed while playing: stays a plain file
+    }
+    return NULL;
+}
+
+static int preloadWorker(void *data) {
+    Preloader *pre = data;
+    for (;;) {
+        SDL_mutexP(pre->lock);
+        if (pre->stopping || pre->nextItem >= pre->count) {
+            SDL_mutexV(pre->lock);
+            return 0;
+        }
+        PreloadItem *item = &pre->items[pre->nextItem++];
+        item->state = PRELOAD_DECODING;
+        SDL_mutexV(pre->lock);
+
+        Uint32 start = SDL_GetTicks();
+        void *result = decodeItem(item);
+
+        SDL_mutexP(pre->lock);
+        item->result = result;
+        item->decodeMs = SDL_GetTicks() - start;
+        item->state = PRELOAD_DECODED;
+        SDL_mutexV(pre->lock);
+    }
+}
+
+void initPreloader(Preloader *pre) {
+    memset(pre, 0, sizeof(*pre));
+    pre->lock = SDL_CreateMutex();
+}
+
+int addPreload(Preloader *pre, const char *path, PreloadType type) {
+    if (pre->count >= MAX_PRELOAD_ITEMS || pre->startTime)
+        return -1;
+    PreloadItem *item = &pre->items[pre->count];
+    item->path = path;
+    item->type = type;
+    item->state = PRELOAD_PENDING;
+    return pre->count++;
+}
+
+int addStretchedPreload(Preloader *pre, const char *path, int w, int h) {
+    int index = addPreload(pre, path, PRELOAD_STRETCHED_IMAGE);
+    if (index >= 0) {
+        pre->items[index].w = w;
+        pre->items[index].h = h;
+    }
+    return index;
+}
+
+void startPreloader(Preloader *pre) {
+    pre->startTime = SDL_GetTicks();
+    for (int i = 0; i < PRELOAD_WORKERS; i++)
+        pre->workers[i] = SDL_CreateThread(preloadWorker, pre);
+}
+
+// Finishes decoded items on the main thread. Returns how many became
+// ready (or failed) during this call.
+int pollPreloader(Preloader *pre) {
+    int finishedNow = 0;
+    for (int i = 0; i < pre->count; i++) {
+        PreloadItem *item = &pre->items[i];
+        SDL_mutexP(pre->lock);
+        int decoded = (item->state == PRELOAD_DECODED);
+        SDL_mutexV(pre->lock);
+        if (!decoded)
+            continue;
+
+        Uint32 start = SDL_GetTicks();
+        if (!item->result) {
+            printf("Preload failed: %s\n", item->path);
+            item->state = PRELOAD_FAILED;
+        } else {
+            switch (item->type) {
+            case PRELOAD_IMAGE:
+                adoptAsset(ASSET_IMAGE, item->path, optimizeSurface(item->result, 1));
+                item->result = NULL;
+                break;
+            case PRELOAD_OPAQUE_IMAGE:
+                adoptAsset(ASSET_OPAQUE_IMAGE, item->path, optimizeOpaqueSurface(item->result));
+                item->result = NULL;
+                break;
+            case PRELOAD_STRETCHED_IMAGE:
+                item->result = optimizeOpaqueSurface(item->result);
+                break;
+            case PRELOAD_SOUND:
+                adoptAsset(ASSET_SOUND, item->path, item->result);
+                item->result = NULL;
+                break;
+            case PRELOAD_DECODED_IMAGE:
+            case PRELOAD_MUSIC:
+                break;
+            }
+            item->state = PRELOAD_READY;
+        }
+        item->finishMs = SDL_GetTicks() - start;
+        pre->finished++;
+        finishedNow++;
+    }
+
+    if (finishedNow && isPreloadDone(pre)) {
+        pre->totalMs = SDL_GetTicks() - pre->startTime;
+        for (int i = 0; i < PRELOAD_WORKERS; i++) {
+            if (pre->workers[i])
+                SDL_WaitThread(pre->workers[i], NULL);
+            pre->workers[i] = NULL;
+        }
+    }
+    return finishedNow;
+}
+
+int isPreloadDone(const Preloader *pre) {
+    return pre->finished == pre->count;
+}
+
+int isPreloadReady(const Preloader *pre, int index) {
+    return index >= 0 && index < pre->count && pre->items[index].state == PRELOAD_READY;
+}
+
+float getPreloadProgress(const Preloader *pre) {
+    return pre->count ? (float)pre->finished / pre->count : 1.0f;
+}
+
+void* takePreloaded(Preloader *pre, int index) {
+    if (!isPreloadReady(pre, index))
+        return NULL;
+    void *result = pre->items[index].result;
+    pre->items[index].result = NULL;
+    return result;
+}
+
+void printPreloadTimings(const Preloader *pre) {
+    printf("%-24s %10s %10s\n", "preloaded asset", "decode ms", "finish ms");
+    for (int i = 0; i < pre->count; i++) {
+        const PreloadItem *item = &pre->items[i];
+        printf("%-24s %10u %10u%s\n", item->path, item->decodeMs, item->finishMs,
+               item->state == PRELOAD_FAILED ? "  (failed)" : "");
+    }
+    printf("Preloading took %u ms with %d workers\n", pre->totalMs, PRELOAD_WORKERS);
+}
+
+void freePreloader(Preloader *pre) {
+    SDL_mutexP(pre->lock);
+    pre->stopping = 1;
+    SDL_mutexV(pre->lock);
+    for (int i = 0; i < PRELOAD_WORKERS; i++) {
+        if (pre->workers[i])
+            SDL_WaitThread(pre->workers[i], NULL);
+        pre->workers[i] = NULL;
+    }
+
+    // Results nobody took (or decoded after the last poll).
+    for (int i = 0; i < pre->count; i++) {
+        PreloadItem *item = &pre->items[i];
+        if (!item->result)
+            continue;
+        if (item->type == PRELOAD_SOUND)
+            Mix_FreeChunk(item->result);
+        else if (item->type == PRELOAD_MUSIC)
+            Mix_FreeMusic(item->result);
+        else
+            SDL_FreeSurface(item->result);
+        item->result = NULL;
+    }
+    SDL_DestroyMutex(pre->lock);
+}
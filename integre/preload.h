@@ -0,0 +1,63 @@
+#ifndef PRELOAD_H
+#define PRELOAD_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_mixer.h>
+
+#define MAX_PRELOAD_ITEMS 32
+#define PRELOAD_WORKERS 2
+
+typedef enum {
+    PRELOAD_IMAGE,           // Adopted by the asset manager (acquireImage)
+    PRELOAD_OPAQUE_IMAGE,    // Adopted by the asset manager (acquireOpaqueImage)
+    PRELOAD_STRETCHED_IMAGE, // Opaque, stretched to w x h; taken with takePreloaded()
+    PRELOAD_DECODED_IMAGE,   // Decoded only, format untouched; taken with takePreloaded()
+    PRELOAD_SOUND,           // Adopted by the asset manager (acquireSound)
+    PRELOAD_MUSIC            // Taken with takePreloaded()
+} PreloadType;
+
+typedef enum {
+    PRELOAD_PENDING,
+    PRELOAD_DECODING,
+    PRELOAD_DECODED,         // Worker done, waiting for the main thread
+    PRELOAD_READY,
+    PRELOAD_FAILED
+} PreloadState;
+
+typedef struct {
+    const char *path;
+    PreloadType type;
+    int w, h;                // Stretch target for PRELOAD_STRETCHED_IMAGE
+    void *result;
+    PreloadState state;
+    Uint32 decodeMs;         // Time spent on the worker thread
+    Uint32 finishMs;         // Time spent converting on the main thread
+} PreloadItem;
+
+typedef struct {
+    PreloadItem items[MAX_PRELOAD_ITEMS];
+    int count;
+    int nextItem;            // Next item a worker will claim
+    int finished;            // Items READY or FAILED
+    int stopping;
+    SDL_mutex *lock;
+    SDL_Thread *workers[PRELOAD_WORKERS];
+    Uint32 startTime;
+    Uint32 totalMs;          // Wall time until the last item finished
+} Preloader;
+
+// Workers only decode; display-format conversion and registration happen
+// in pollPreloader() on the main thread. Sounds need the audio device open.
+void initPreloader(Preloader *pre);
+int addPreload(Preloader *pre, const char *path, PreloadType type);
+int addStretchedPreload(Preloader *pre, const char *path, int w, int h);
+void startPreloader(Preloader *pre);
+int pollPreloader(Preloader *pre);
+int isPreloadDone(const Preloader *pre);
+int isPreloadReady(const Preloader *pre, int index);
+float getPreloadProgress(const Preloader *pre);
+void* takePreloaded(Preloader *pre, int index);
+void printPreloadTimings(const Preloader *pre);
+void freePreloader(Preloader *pre);
+
+#endif // PRELOAD_H
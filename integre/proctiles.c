@@ -0,0 +1,117 @@
+#include "proctiles.h"
+#include "assets.h"
+#include <SDL/SDL_gfxPrimitives.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROC_HUES 12
+#define PROC_SHAPES 4
+
+typedef struct {
+    int tileSize;
+    int capacity;
+    SDL_Surface **tiles;   // Indexed by id
+} ProcTileSet;
+
+static ProcTileSet sets[MAX_PROC_TILE_SIZES];
+static int setCount = 0;
+
+// Fully saturated hue (0..PROC_HUES-1) scaled to the given brightness.
+static Uint32 hueColor(int hue, int value) {
+    int sector = hue * 6 / PROC_HUES;
+    int rise = (hue * 6 % PROC_HUES) * value / PROC_HUES;
+    int fall = value - rise;
+    int r, g, b;
+    switch (sector) {
+    case 0: r = value; g = rise; b = 0; break;
+    case 1: r = fall; g = value; b = 0; break;
+    case 2: r = 0; g = value; b = rise; break;
+    case 3: r = 0; g = fall; b = value; break;
+    case 4: r = rise; g = 0; b = value; break;
+    default: r = value; g = 0; b = fall; break;
+    }
+    return ((Uint32)r << 24) | ((Uint32)g << 16) | ((Uint32)b << 8) | 0xFF;
+}
+
+static SDL_Surface* drawTile(int id, int size) {
+    SDL_Surface *surf = SDL_CreateRGBSurface(SDL_SWSURFACE, size, size, 32,
+        0x00FF0000, 0x0000FF00, 0x000000FF, 0);
+    if (!surf)
+        return NULL;
+    int hue = id % PROC_HUES;
+    int shape = (id / PROC_HUES) % PROC_SHAPES;
+    int c = size / 2, r = size * 3 / 8;
+    Uint32 fg = hueColor(hue, 255);
+
+    boxColor(surf, 0, 0, size - 1, size - 1, hueColor((hue + PROC_HUES / 2) % PROC_HUES, 90));
+    switch (shape) {
+    case 0:
+        filledCircleColor(surf, c, c, r, fg);
+        break;
+    case 1:
+        boxColor(surf, c - r, c - r, c + r, c + r, fg);
+        break;
+    case 2:
+        filledTrigonColor(surf, c, c - r, c + r, c, c - r, c, fg);
+        filledTrigonColor(surf, c, c + r, c + r, c, c - r, c, fg);
+        break;
+    default:
+        filledCircleColor(surf, c, c, r, fg);
+        filledCircleColor(surf, c, c, r / 2, 0x000000FF);
+        break;
+    }
+    // The pair number keeps faces distinct beyond hues x shapes.
+    if (size >= 24) {
+        char label[8];
+        snprintf(label, sizeof(label), "%d", id + 1);
+        stringColor(surf, 2, 2, label, 0xFFFFFFFF);
+    }
+    return optimizeOpaqueSurface(surf);
+}
+
+static ProcTileSet* findSet(int tileSize) {
+    for (int i = 0; i < setCount; i++) {
+        if (sets[i].tileSize == tileSize)
+            return &sets[i];
+    }
+    if (setCount == MAX_PROC_TILE_SIZES) {
+        fprintf(stderr, "Erreur : trop de tailles de tuiles generees (%d)\n", tileSize);
+        return NULL;
+    }
+    ProcTileSet *set = &sets[setCount++];
+    memset(set, 0, sizeof(*set));
+    set->tileSize = tileSize;
+    return set;
+}
+
+SDL_Surface* getProceduralTile(int id, int tileSize) {
+    ProcTileSet *set = findSet(tileSize);
+    if (!set || id < 0)
+        return NULL;
+    if (id >= set->capacity) {
+        int capacity = set->capacity ? set->capacity : 64;
+        while (capacity <= id)
+            capacity *= 2;
+        SDL_Surface **grown = realloc(set->tiles, capacity * sizeof(SDL_Surface *));
+        if (!grown)
+            return NULL;
+        memset(grown + set->capacity, 0, (capacity - set->capacity) * sizeof(SDL_Surface *));
+        set->tiles = grown;
+        set->capacity = capacity;
+    }
+    if (!set->tiles[id])
+        set->tiles[id] = drawTile(id, tileSize);
+    return set->tiles[id];
+}
+
+void freeProceduralTiles(void) {
+    for (int i = 0; i < setCount; i++) {
+        for (int j = 0; j < sets[i].capacity; j++) {
+            if (sets[i].tiles[j])
+                SDL_FreeSurface(sets[i].tiles[j]);
+        }
+        free(sets[i].tiles);
+    }
+    setCount = 0;
+}
@@ -0,0 +1,14 @@
+#ifndef PROCTILES_H
+#define PROCTILES_H
+
+#include <SDL/SDL.h>
+
+#define MAX_PROC_TILE_SIZES 8
+
+// Generated faces for boards with more pairs than there are images:
+// colour, shape and the pair number are derived from the id. Tiles are
+// drawn on first use and cached per (id, size); the cache owns them.
+SDL_Surface* getProceduralTile(int id, int tileSize);
+void freeProceduralTiles(void);
+
+#endif // PROCTILES_H
@@ -0,0 +1,278 @@
+#include "qbank.h"
+#include "pak.h"
+#include "strpool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    Uint8 *data;
+    size_t size;
+    size_t capacity;
+} Buffer;
+
+static int appendBytes(Buffer *b, const void *data, size_t n) {
+    if (b->size + n > b->capacity) {
+        size_t capacity = b->capacity ? b->capacity : 4096;
+        while (capacity < b->size + n)
+            capacity *= 2;
+        Uint8 *grown = realloc(b->data, capacity);
+        if (!grown)
+            return 0;
+        b->data = grown;
+        b->capacity = capacity;
+    }
+    memcpy(b->data + b->size, data, n);
+    b->size += n;
+    return 1;
+}
+
+// Interns one line of the text file. Lines that are not UTF-8 are taken
+// as Latin-1, which older question files were saved in.
+static long internLine(StringPool *pool, const char *line, const char *textPath, int lineNumber) {
+    size_t length = strlen(line);
+    if (isValidUtf8(line, length))
+        return internString(pool, line, length);
+    fprintf(stderr, "%s:%d: pas en UTF-8, lu comme Latin-1\n", textPath, lineNumber);
+    char *converted = latin1ToUtf8(line, length, &length);
+    long offset = converted ? internString(pool, converted, length) : -1;
+    free(converted);
+    return offset;
+}
+
+static int attachImage(QuestionBank *bank, const Uint8 *image, size_t size, int mapped) {
+    const QBankHeader *hdr = (const QBankHeader *)image;
+    if (size < sizeof(QBankHeader) || hdr->magic != QBANK_MAGIC || hdr->version != QBANK_VERSION)
+        return 0;
+    // Sections must fit; records are checked one by one as they are read.
+    if (hdr->categoriesOffset % 4 || hdr->recordsOffset % 4 || hdr->poolOffset % 4 ||
+        (size_t)hdr->categoriesOffset + (size_t)hdr->categoryCount * sizeof(Uint32) > size ||
+        (size_t)hdr->recordsOffset + (size_t)hdr->count * sizeof(QBankRecord) > size ||
+        (size_t)hdr->poolOffset + hdr->poolSize > size || hdr->count > 0x7FFFFFFF)
+        return 0;
+
+    bank->image = image;
+    bank->size = size;
+    bank->mapped = mapped;
+    bank->header = hdr;
+    bank->categories = (const Uint32 *)(image + hdr->categoriesOffset);
+    bank->records = (const QBankRecord *)(image + hdr->recordsOffset);
+    bank->pool = image + hdr->poolOffset;
+    bank->count = (int)hdr->count;
+    return 1;
+}
+
+int openQuestionBank(QuestionBank *bank, const char *path) {
+    memset(bank, 0, sizeof(*bank));
+    size_t size;
+    const Uint8 *image = mapAsset(path, &size);
+    if (!image)
+        return 0;
+    if (!attachImage(bank, image, size, 1)) {
+        fprintf(stderr, "Erreur : banque de questions %s invalide\n", path);
+        unmapAsset(image, size);
+        return 0;
+    }
+    return 1;
+}
+
+static char* readLine(FILE *fp, char **line, size_t *capacity) {
+    ssize_t n = getline(line, capacity, fp);
+    if (n < 0)
+        return NULL;
+    while (n > 0 && ((*line)[n - 1] == '\n' || (*line)[n - 1] == '\r'))
+        (*line)[--n] = '\0';
+    return *line;
+}
+
+// Interned names are equal exactly when their offsets are.
+static int addCategory(Buffer *categories, long offset) {
+    if (offset < 0)
+        return -1;
+    const Uint32 *offsets = (const Uint32 *)categories->data;
+    int count = (int)(categories->size / sizeof(Uint32));
+    for (int i = 0; i < count; i++) {
+        if (offsets[i] == (Uint32)offset)
+            return i;
+    }
+    Uint32 stored = (Uint32)offset;
+    if (count >= QBANK_MAX_CATEGORIES || !appendBytes(categories, &stored, sizeof(stored)))
+        return -1;
+    return count;
+}
+
+int compileQuestionText(QuestionBank *bank, const char *textPath) {
+    memset(bank, 0, sizeof(*bank));
+    FILE *fp = openAssetFile(textPath);
+    if (!fp)
+        return 0;
+    int ok = compileQuestionStream(bank, fp, textPath);
+    fclose(fp);
+    return ok;
+}
+
+int compileQuestionStream(QuestionBank *bank, FILE *fp, const char *textPath) {
+    memset(bank, 0, sizeof(*bank));
+    StringPool pool;
+    Buffer records = {0}, categories = {0};
+    initStringPool(&pool);
+    char *line = NULL;
+    size_t capacity = 0;
+    int category = -1, difficulty = 1, ok = 1, lineNumber = 0;
+
+    while (ok && readLine(fp, &line, &capacity)) {
+        lineNumber++;
+        if (line[0] == '\0')
+            continue;
+        if (line[0] == '[') {
+            char *close = strchr(line, ']');
+            if (!close) {
+                fprintf(stderr, "%s:%d: categorie sans ']'\n", textPath, lineNumber);
+                continue;
+            }
+            *close = '\0';
+            difficulty = (int)strtol(close + 1, NULL, 10);
+            if (difficulty < 1)
+                difficulty = 1;
+            category = addCategory(&categories, internLine(&pool, line + 1, textPath, lineNumber));
+            ok = category >= 0;
+            continue;
+        }
+
+        // Questions before any category line go to a default one.
+        if (category < 0) {
+            category = addCategory(&categories, internString(&pool, "General", 7));
+            if (category < 0) {
+                ok = 0;
+                break;
+            }
+        }
+        QBankRecord r = {0};
+        r.category = (Uint16)category;
+        r.difficulty = (Uint16)difficulty;
+        long offset = internLine(&pool, line, textPath, lineNumber);
+        r.question = (Uint32)offset;
+        ok = offset >= 0;
+        for (int j = 0; j < 3 && ok; j++) {
+            if (!readLine(fp, &line, &capacity)) {
+                fprintf(stderr, "%s: question incomplete en fin de fichier\n", textPath);
+                break;
+            }
+            lineNumber++;
+            offset = internLine(&pool, line, textPath, lineNumber);
+            r.answers[j] = (Uint32)offset;
+            ok = offset >= 0;
+            if (ok && j == 2)
+                ok = appendBytes(&records, &r, sizeof(r));
+        }
+    }
+    free(line);
+
+    ok = ok && buildQuestionBank(bank, &pool, (const QBankRecord *)records.data,
+                                 (Uint32)(records.size / sizeof(QBankRecord)),
+                                 (const Uint32 *)categories.data, (Uint32)(categories.size / sizeof(Uint32)));
+    freeStringPool(&pool);
+    free(records.data);
+    free(categories.data);
+    return ok;
+}
+
+// One image in the file layout, so a bank built in memory reads the same way.
+int buildQuestionBank(QuestionBank *bank, const StringPool *pool, const QBankRecord *records, Uint32 count,
+                      const Uint32 *categories, Uint32 categoryCount) {
+    memset(bank, 0, sizeof(*bank));
+    size_t recordBytes = (size_t)count * sizeof(QBankRecord);
+    size_t categoryBytes = (size_t)categoryCount * sizeof(Uint32);
+    if (count == 0 || sizeof(QBankHeader) + categoryBytes + recordBytes + pool->size > 0xFFFFFFFFu)
+        return 0;
+
+    QBankHeader hdr = {QBANK_MAGIC, QBANK_VERSION, count, categoryCount, 0, 0, 0, (Uint32)pool->size};
+    hdr.categoriesOffset = sizeof(QBankHeader);
+    hdr.recordsOffset = hdr.categoriesOffset + (Uint32)categoryBytes;
+    hdr.poolOffset = hdr.recordsOffset + (Uint32)recordBytes;
+    Buffer image = {0};
+    int ok = appendBytes(&image, &hdr, sizeof(hdr)) &&
+             appendBytes(&image, categories, categoryBytes) &&
+             appendBytes(&image, records, recordBytes) &&
+             appendBytes(&image, pool->data, pool->size);
+    if (!ok || !attachImage(bank, image.data, image.size, 0)) {
+        free(image.data);
+        memset(bank, 0, sizeof(*bank));
+        return 0;
+    }
+    bank->textBytes = pool->requestedBytes;
+    return 1;
+}
+
+int loadQuestionBank(QuestionBank *bank, const char *compiledPath, const char *textPath) {
+    // An edited text file wins over a bank compiled before the edit.
+    long compiledMtime = assetMtime(compiledPath), textMtime = assetMtime(textPath);
+    if (compiledMtime >= 0 && textMtime > compiledMtime) {
+        printf("%s is newer than %s: compiling it at startup (rerun compile_qbank)\n", textPath, compiledPath);
+        if (compileQuestionText(bank, textPath))
+            return 1;
+    }
+    if (openQuestionBank(bank, compiledPath))
+        return 1;
+    return compileQuestionText(bank, textPath);
+}
+
+int writeQuestionBank(const QuestionBank *bank, const char *path) {
+    FILE *fp = fopen(path, "wb");
+    if (!fp)
+        return 0;
+    int ok = fwrite(bank->image, 1, bank->size, fp) == bank->size;
+    if (fclose(fp) != 0)
+        ok = 0;
+    if (!ok)
+        remove(path);
+    return ok;
+}
+
+static StringView bankString(const QuestionBank *bank, Uint32 offset) {
+    return poolString(bank->pool, bank->header->poolSize, offset);
+}
+
+int getBankQuestion(const QuestionBank *bank, int id, Question *out) {
+    if (id < 0 || id >= bank->count)
+        return 0;
+    const QBankRecord *r = &bank->records[id];
+    StringView answers[3];
+    out->question = bankString(bank, r->question);
+    for (int j = 0; j < 3; j++)
+        answers[j] = bankString(bank, r->answers[j]);
+    if (!out->question.length || !answers[0].length)
+        return 0;   // Corrupt record
+
+    // Shuffle answers
+    int indices[3] = {0, 1, 2};
+    for (int j = 2; j > 0; j--) {
+        int k = rand() % (j + 1);
+        int temp = indices[j];
+        indices[j] = indices[k];
+        indices[k] = temp;
+    }
+    for (int j = 0; j < 3; j++) {
+        out->answers[j] = answers[indices[j]];
+        if (indices[j] == 0)
+            out->correctAnswer = j;
+    }
+    out->id = id;
+    out->category = r->category;
+    out->difficulty = r->difficulty;
+    return 1;
+}
+
+const char* getBankCategory(const QuestionBank *bank, int category) {
+    if (category < 0 || category >= (int)bank->header->categoryCount)
+        return "";
+    return bankString(bank, bank->categories[category]).text;
+}
+
+void closeQuestionBank(QuestionBank *bank) {
+    if (bank->mapped)
+        unmapAsset(bank->image, bank->size);
+    else
+        free((void *)bank->image);
+    memset(bank, 0, sizeof(*bank));
+}
@@ -0,0 +1,75 @@
+#ifndef QBANK_H
+#define QBANK_H
+
+#include "header.h"
+#include "strpool.h"
+#include <stddef.h>
+
+#define QBANK_FILE "questions.qbank"
+#define QUESTION_TEXT_FILE "sciencefiction_quiz.txt"
+#define QBANK_MAGIC 0x4B4E4251  // "QBNK"
+#define QBANK_VERSION 2
+#define QBANK_MAX_CATEGORIES 65535
+
+// Compiled bank, written by tools/compile_qbank.c: a header, the category
+// names, one fixed-size record per question, then the string pool
+// (strpool.h) the records point into. Section offsets are from the file
+// start, string offsets from the start of the pool; repeated strings
+// (answers like "Mars", category names) are stored once.
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 count;              // Questions
+    Uint32 categoryCount;
+    Uint32 categoriesOffset;   // Uint32[categoryCount]: pool offsets of the names
+    Uint32 recordsOffset;      // QBankRecord[count]
+    Uint32 poolOffset;
+    Uint32 poolSize;
+} QBankHeader;
+
+typedef struct {
+    Uint32 question;           // Pool offsets
+    Uint32 answers[3];         // answers[0] is the correct one
+    Uint16 category;
+    Uint16 difficulty;         // 1 (easy) and up
+} QBankRecord;
+
+// A bank is one read-only image, mapped from disk (or the asset archive)
+// or compiled in memory from the text format. Questions are read by id
+// straight from the image, so memory does not grow with the bank.
+typedef struct {
+    const Uint8 *image;
+    size_t size;
+    int mapped;                // 0: image was compiled in memory and is freed
+    const QBankHeader *header;
+    const QBankRecord *records;
+    const Uint32 *categories;
+    const Uint8 *pool;
+    int count;
+    size_t textBytes;          // Text before interning, when compiled in memory
+} QuestionBank;
+
+int openQuestionBank(QuestionBank *bank, const char *path);
+// Text format: four lines per question (the question, the right answer,
+// two wrong ones). A "[Category]" line, optionally followed by a
+// difficulty ("[Space] 2"), applies to the questions after it. Text is
+// UTF-8 of any length; lines that are not UTF-8 are read as Latin-1.
+int compileQuestionText(QuestionBank *bank, const char *textPath);
+// Same from an open file; `textPath` only names it in warnings.
+int compileQuestionStream(QuestionBank *bank, FILE *fp, const char *textPath);
+// Bank image from parts built elsewhere (tools/import_questions.c): record
+// and category offsets are into `pool`, which the bank copies.
+int buildQuestionBank(QuestionBank *bank, const StringPool *pool, const QBankRecord *records, Uint32 count,
+                      const Uint32 *categories, Uint32 categoryCount);
+// Compiled bank if there is one and the text file is not newer, else the
+// text file.
+int loadQuestionBank(QuestionBank *bank, const char *compiledPath, const char *textPath);
+int writeQuestionBank(const QuestionBank *bank, const char *path);
+// Fills `out` with question `id`, answers shuffled. The views point into
+// the bank and stay valid until it is closed. Returns 0 if `id` is out of
+// range or its record is corrupt.
+int getBankQuestion(const QuestionBank *bank, int id, Question *out);
+const char* getBankCategory(const QuestionBank *bank, int category);
+void closeQuestionBank(QuestionBank *bank);
+
+#endif // QBANK_H
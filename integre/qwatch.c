@@ -0,0 +1,163 @@
+#include "qwatch.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+static const char* baseName(const char *path) {
+    const char *slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+// Compiles the saved file and hands it over, replacing a reload the game
+// has not taken yet. On failure the game simply keeps its current bank.
+static void reloadBank(BankWatcher *w) {
+    QuestionBank bank;
+    Sampler order;
+    FILE *fp = fopen(w->path, "rb");   // The file on disk, not a packed copy
+    int ok = fp && compileQuestionStream(&bank, fp, w->path);
+    if (fp)
+        fclose(fp);
+    if (ok && !initBankSampler(&order, &bank, w->key, w->seed + w->reloads + 1)) {
+        closeQuestionBank(&bank);
+        ok = 0;
+    }
+
+    SDL_mutexP(w->lock);
+    if (!ok) {
+        w->failures++;
+        SDL_mutexV(w->lock);
+        printf("Question reload failed: %s (keeping the current questions)\n", w->path);
+        return;
+    }
+    if (w->ready) {
+        closeQuestionBank(&w->bank);
+        freeSampler(&w->order);
+    }
+    w->bank = bank;
+    w->order = order;
+    w->ready = 1;
+    w->reloads++;
+    SDL_mutexV(w->lock);
+}
+
+static int watchThread(void *data) {
+    BankWatcher *w = data;
+    const char *name = baseName(w->path);
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int changed = 0;
+
+    for (;;) {
+        SDL_mutexP(w->lock);
+        int stopping = w->stopping;
+        SDL_mutexV(w->lock);
+        if (stopping)
+            return 0;
+
+        // Editors save in bursts (truncate, write, rename): reload once the
+        // file has been quiet for a moment.
+        struct pollfd pfd = {w->fd, POLLIN, 0};
+        int events = poll(&pfd, 1, changed ? QWATCH_SETTLE_MS : QWATCH_POLL_MS);
+        if (events > 0) {
+            ssize_t n = read(w->fd, buffer, sizeof(buffer));
+            for (char *p = buffer; n > 0 && p < buffer + n; ) {
+                const struct inotify_event *e = (const struct inotify_event *)p;
+                if (e->len && strcmp(e->name, name) == 0)
+                    changed = 1;
+                p += sizeof(struct inotify_event) + e->len;
+            }
+        } else if (events == 0 && changed) {
+            changed = 0;
+            reloadBank(w);
+        }
+    }
+}
+#endif
+
+int startBankWatcher(BankWatcher *w, const char *textPath, SampleKey key, Uint64 seed) {
+    memset(w, 0, sizeof(*w));
+    w->fd = -1;
+#ifdef __linux__
+    snprintf(w->path, sizeof(w->path), "%s", textPath);
+    w->key = key;
+    w->seed = seed;
+
+    // Watch the directory: saving by rename replaces the file's inode.
+    char dir[256];
+    snprintf(dir, sizeof(dir), "%s", textPath);
+    char *slash = strrchr(dir, '/');
+    if (slash)
+        *slash = '\0';
+    else
+        strcpy(dir, ".");
+
+    w->fd = inotify_init();
+    if (w->fd < 0)
+        return 0;
+    w->wd = inotify_add_watch(w->fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+    w->lock = SDL_CreateMutex();
+    if (w->wd < 0 || !w->lock) {
+        stopBankWatcher(w);
+        return 0;
+    }
+    w->thread = SDL_CreateThread(watchThread, w);
+    if (!w->thread) {
+        stopBankWatcher(w);
+        return 0;
+    }
+    return 1;
+#else
+    (void)textPath;
+    (void)key;
+    (void)seed;
+    return 0;
+#endif
+}
+
+int takeReloadedBank(BankWatcher *w, QuestionBank *bank, Sampler *order) {
+    if (!w->lock)
+        return 0;
+    SDL_mutexP(w->lock);
+    if (!w->ready) {
+        SDL_mutexV(w->lock);
+        return 0;
+    }
+    QuestionBank oldBank = *bank;
+    Sampler oldOrder = *order;
+    *bank = w->bank;
+    *order = w->order;
+    w->ready = 0;
+    SDL_mutexV(w->lock);
+
+    closeQuestionBank(&oldBank);
+    freeSampler(&oldOrder);
+    return 1;
+}
+
+void stopBankWatcher(BankWatcher *w) {
+    if (w->lock) {
+        SDL_mutexP(w->lock);
+        w->stopping = 1;
+        SDL_mutexV(w->lock);
+    }
+    if (w->thread)
+        SDL_WaitThread(w->thread, NULL);   // Wakes within QWATCH_POLL_MS
+    w->thread = NULL;
+#ifdef __linux__
+    if (w->fd >= 0)
+        close(w->fd);
+#endif
+    w->fd = -1;
+    if (w->ready) {
+        closeQuestionBank(&w->bank);
+        freeSampler(&w->order);
+        w->ready = 0;
+    }
+    if (w->lock)
+        SDL_DestroyMutex(w->lock);
+    w->lock = NULL;
+}
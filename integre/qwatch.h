@@ -0,0 +1,36 @@
+#ifndef QWATCH_H
+#define QWATCH_H
+
+#include "qbank.h"
+#include "sampler.h"
+
+#define QWATCH_SETTLE_MS 150   // Quiet time after the last write before reloading
+#define QWATCH_POLL_MS 250     // How often the thread checks for shutdown
+
+// Watches a question text file (inotify, Linux only) and compiles every
+// saved version on its own thread, sampler included, so the game only
+// swaps two structs when it takes the new bank.
+typedef struct {
+    char path[256];
+    int fd;
+    int wd;
+    SDL_Thread *thread;
+    SDL_mutex *lock;
+    int stopping;
+    int ready;                 // bank and order hold a reload not taken yet
+    QuestionBank bank;
+    Sampler order;
+    SampleKey key;
+    Uint64 seed;
+    int reloads;
+    int failures;
+} BankWatcher;
+
+// Returns 0 (and the game keeps its bank) if the file cannot be watched.
+int startBankWatcher(BankWatcher *w, const char *textPath, SampleKey key, Uint64 seed);
+// Call between questions: if a reload is waiting, swaps it into bank and
+// order and frees the old ones. Views into the old bank die with it.
+int takeReloadedBank(BankWatcher *w, QuestionBank *bank, Sampler *order);
+void stopBankWatcher(BankWatcher *w);
+
+#endif // QWATCH_H
@@ -0,0 +1,48 @@
+#include "rawimage.h"
+
+int writeRawImage(FILE *fp, SDL_Surface *surface) {
+    RawImageHeader hdr;
+    hdr.w = surface->w;
+    hdr.h = surface->h;
+    hdr.bpp = surface->format->BitsPerPixel;
+    hdr.rmask = surface->format->Rmask;
+    hdr.gmask = surface->format->Gmask;
+    hdr.bmask = surface->format->Bmask;
+    hdr.amask = surface->format->Amask;
+    if (hdr.bpp < 15 || fwrite(&hdr, sizeof(hdr), 1, fp) != 1)
+        return 0;
+
+    size_t rowBytes = (size_t)surface->w * surface->format->BytesPerPixel;
+    int ok = 1;
+    SDL_LockSurface(surface);
+    for (int y = 0; y < surface->h && ok; y++) {
+        const Uint8 *row = (const Uint8 *)surface->pixels + (size_t)y * surface->pitch;
+        ok = fwrite(row, 1, rowBytes, fp) == rowBytes;
+    }
+    SDL_UnlockSurface(surface);
+    return ok;
+}
+
+SDL_Surface* readRawImage(FILE *fp) {
+    RawImageHeader hdr;
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1)
+        return NULL;
+    if (hdr.w == 0 || hdr.h == 0 || hdr.w > 16384 || hdr.h > 16384 ||
+        (hdr.bpp != 16 && hdr.bpp != 24 && hdr.bpp != 32))
+        return NULL;
+
+    SDL_Surface *surface = SDL_CreateRGBSurface(SDL_SWSURFACE, hdr.w, hdr.h, hdr.bpp,
+                                                hdr.rmask, hdr.gmask, hdr.bmask, hdr.amask);
+    if (!surface)
+        return NULL;
+
+    size_t rowBytes = (size_t)hdr.w * surface->format->BytesPerPixel;
+    for (Uint32 y = 0; y < hdr.h; y++) {
+        Uint8 *row = (Uint8 *)surface->pixels + (size_t)y * surface->pitch;
+        if (fread(row, 1, rowBytes, fp) != rowBytes) {
+            SDL_FreeSurface(surface);
+            return NULL;
+        }
+    }
+    return surface;
+}
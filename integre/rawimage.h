@@ -0,0 +1,19 @@
+#ifndef RAWIMAGE_H
+#define RAWIMAGE_H
+
+#include <SDL/SDL.h>
+#include <stdio.h>
+
+// Uncompressed surface dump: a small header (size, depth, channel masks)
+// followed by the rows without pitch padding, in native byte order.
+// Meant for caches rebuilt on the same machine, not for distribution.
+typedef struct {
+    Uint32 w, h;
+    Uint32 bpp;
+    Uint32 rmask, gmask, bmask, amask;
+} RawImageHeader;
+
+int writeRawImage(FILE *fp, SDL_Surface *surface);
+SDL_Surface* readRawImage(FILE *fp);
+
+#endif // RAWIMAGE_H
@@ -0,0 +1,155 @@
+#include "sampler.h"
+#include <stdlib.h>
+#include <string.h>
+
+void seedRng(Rng *rng, Uint64 seed, Uint64 stream) {
+    rng->state = 0;
+    rng->inc = (stream << 1) | 1;
+    nextRng(rng);
+    rng->state += seed;
+    nextRng(rng);
+}
+
+Uint32 nextRng(Rng *rng) {
+    Uint64 old = rng->state;
+    rng->state = old * 6364136223846793005ULL + rng->inc;
+    Uint32 xorshifted = (Uint32)(((old >> 18) ^ old) >> 27);
+    Uint32 rot = (Uint32)(old >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
+}
+
+// Lemire's multiply-and-reject: one multiplication, and a retry only for
+// the few values that would make some results more likely than others.
+Uint32 boundedRng(Rng *rng, Uint32 bound) {
+    Uint64 m = (Uint64)nextRng(rng) * bound;
+    Uint32 low = (Uint32)m;
+    if (low < bound) {
+        Uint32 threshold = -bound % bound;
+        while (low < threshold) {
+            m = (Uint64)nextRng(rng) * bound;
+            low = (Uint32)m;
+        }
+    }
+    return (Uint32)(m >> 32);
+}
+
+static Uint32 slotValue(const Sampler *s, Uint32 slot) {
+    return s->stamp[slot] == s->epoch ? s->perm[slot] : s->order[slot];
+}
+
+static void setSlot(Sampler *s, Uint32 slot, Uint32 value) {
+    s->perm[slot] = value;
+    s->stamp[slot] = s->epoch;
+}
+
+static int groupOf(int key) {
+    return key < SAMPLER_MAX_GROUPS ? key : SAMPLER_MAX_GROUPS - 1;
+}
+
+int initSampler(Sampler *s, const Uint16 *keys, Uint32 count, Uint64 seed) {
+    memset(s, 0, sizeof(*s));
+    s->order = malloc(count * sizeof(Uint32) + 1);
+    s->perm = malloc(count * sizeof(Uint32) + 1);
+    s->stamp = calloc(count + 1, sizeof(Uint32));
+    if (!s->order || !s->perm || !s->stamp) {
+        freeSampler(s);
+        return 0;
+    }
+    s->count = count;
+    s->epoch = 1;
+    seedRng(&s->rng, seed, 0x51554955ULL);
+
+    // Counting sort of the ids by group, once.
+    for (Uint32 i = 0; i < count; i++) {
+        int g = groupOf(keys[i]);
+        s->groups[g].size++;
+        if (g >= s->groupCount)
+            s->groupCount = g + 1;
+    }
+    Uint32 start = 0;
+    for (int g = 0; g < s->groupCount; g++) {
+        s->groups[g].start = start;
+        s->groups[g].weight = 1;
+        start += s->groups[g].size;
+    }
+    Uint32 fill[SAMPLER_MAX_GROUPS] = {0};
+    for (Uint32 i = 0; i < count; i++) {
+        int g = groupOf(keys[i]);
+        s->order[s->groups[g].start + fill[g]++] = i;
+    }
+    s->remaining = count;
+    return 1;
+}
+
+int initBankSampler(Sampler *s, const QuestionBank *bank, SampleKey key, Uint64 seed) {
+    Uint16 *keys = malloc(bank->count * sizeof(Uint16) + 1);
+    if (!keys)
+        return 0;
+    for (int i = 0; i < bank->count; i++)
+        keys[i] = (key == SAMPLE_BY_CATEGORY) ? bank->records[i].category : bank->records[i].difficulty;
+    int ok = initSampler(s, keys, bank->count, seed);
+    free(keys);
+    return ok;
+}
+
+void setSamplerWeight(Sampler *s, int key, Uint32 weight) {
+    if (key >= 0)
+        s->groups[groupOf(key)].weight = weight;
+}
+
+int drawSample(Sampler *s) {
+    // Weighted pick among the groups that still have items.
+    Uint64 total = 0;
+    for (int g = 0; g < s->groupCount; g++) {
+        if (s->groups[g].drawn < s->groups[g].size)
+            total += s->groups[g].weight;
+    }
+    if (total == 0)
+        return -1;
+    Uint64 pick;
+    if (total <= 0xFFFFFFFFu) {
+        pick = boundedRng(&s->rng, (Uint32)total);
+    } else {
+        Uint64 high = nextRng(&s->rng);
+        pick = ((high << 32) | nextRng(&s->rng)) % total;   // Huge weights: bias is negligible
+    }
+    SampleGroup *group = NULL;
+    for (int g = 0; g < s->groupCount; g++) {
+        if (s->groups[g].drawn == s->groups[g].size)
+            continue;
+        if (pick < s->groups[g].weight) {
+            group = &s->groups[g];
+            break;
+        }
+        pick -= s->groups[g].weight;
+    }
+
+    // One Fisher-Yates step: swap a random unused slot into the next one.
+    Uint32 next = group->start + group->drawn;
+    Uint32 chosen = next + boundedRng(&s->rng, group->size - group->drawn);
+    Uint32 value = slotValue(s, chosen);
+    if (chosen != next)
+        setSlot(s, chosen, slotValue(s, next));
+    setSlot(s, next, value);
+    group->drawn++;
+    s->remaining--;
+    return (int)value;
+}
+
+void resetSampler(Sampler *s) {
+    if (++s->epoch == 0) {
+        // Wrapped after 4 billion resets: old stamps could look current.
+        memset(s->stamp, 0, s->count * sizeof(Uint32));
+        s->epoch = 1;
+    }
+    for (int g = 0; g < s->groupCount; g++)
+        s->groups[g].drawn = 0;
+    s->remaining = s->count;
+}
+
+void freeSampler(Sampler *s) {
+    free(s->order);
+    free(s->perm);
+    free(s->stamp);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,60 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <SDL/SDL.h>
+#include "qbank.h"
+
+#define SAMPLER_MAX_GROUPS 64   // Keys past this share the last group
+
+// PCG32: small, fast and seedable, so a draw sequence can be replayed.
+typedef struct {
+    Uint64 state;
+    Uint64 inc;
+} Rng;
+
+void seedRng(Rng *rng, Uint64 seed, Uint64 stream);
+Uint32 nextRng(Rng *rng);
+// Uniform in [0, bound) without the bias of `% bound`.
+Uint32 boundedRng(Rng *rng, Uint32 bound);
+
+typedef enum {
+    SAMPLE_BY_CATEGORY,
+    SAMPLE_BY_DIFFICULTY
+} SampleKey;
+
+typedef struct {
+    Uint32 start;               // First slot of the group in `order`
+    Uint32 size;
+    Uint32 drawn;               // Slots [start, start + drawn) are used up
+    Uint32 weight;              // Relative chance of drawing from this group
+} SampleGroup;
+
+// Draws items without repeats until every one has come up. Items are
+// grouped by a key (category or difficulty) and groups are picked by
+// weight, then an item inside the group with one step of an incremental
+// Fisher-Yates shuffle: O(1) per draw whatever the item count. Reset is
+// O(1) too: swapped slots are stamped with an epoch, and bumping the epoch
+// makes every slot read as untouched again.
+typedef struct {
+    Uint32 *order;              // Item ids grouped by key, never modified
+    Uint32 *perm;               // Swapped values, valid where stamp == epoch
+    Uint32 *stamp;
+    Uint32 epoch;
+    Uint32 count;
+    Uint32 remaining;
+    SampleGroup groups[SAMPLER_MAX_GROUPS];
+    int groupCount;
+    Rng rng;
+} Sampler;
+
+// keys[i] is item i's group; items are numbered 0 .. count - 1.
+int initSampler(Sampler *s, const Uint16 *keys, Uint32 count, Uint64 seed);
+int initBankSampler(Sampler *s, const QuestionBank *bank, SampleKey key, Uint64 seed);
+// Weight 0 excludes a group; all groups start at 1.
+void setSamplerWeight(Sampler *s, int key, Uint32 weight);
+// Next item id, or -1 once every item with a non-zero weight was drawn.
+int drawSample(Sampler *s);
+void resetSampler(Sampler *s);
+void freeSampler(Sampler *s);
+
+#endif // SAMPLER_H
@@ -0,0 +1,193 @@
+#include "scene.h"
+#include <stdio.h>
+#include <string.h>
+
+static void rememberScene(SceneStack *stack, Scene *scene) {
+    for (int i = 0; i < stack->knownCount; i++) {
+        if (stack->known[i] == scene)
+            return;
+    }
+    if (stack->knownCount < MAX_SCENES * 2)
+        stack->known[stack->knownCount++] = scene;
+}
+
+static Scene* topScene(SceneStack *stack) {
+    return stack->depth > 0 ? stack->scenes[stack->depth - 1] : NULL;
+}
+
+static void enterScene(SceneStack *stack, Scene *scene) {
+    preloadScene(stack, scene);
+    scene->stack = stack;
+    stack->scenes[stack->depth++] = scene;
+    if (scene->enter)
+        scene->enter(scene);
+    markAllDirty(&stack->compositor);
+}
+
+static void leaveScene(SceneStack *stack) {
+    Scene *scene = stack->scenes[--stack->depth];
+    if (scene->exit)
+        scene->exit(scene);
+    scene->stack = NULL;
+    markAllDirty(&stack->compositor);
+}
+
+// Stack changes requested from inside a hook are applied here, between
+// frames, so no scene is torn down while one of its hooks is running.
+static void applyPending(SceneStack *stack) {
+    for (int i = 0; i < stack->pendingCount; i++) {
+        Scene *scene = stack->pending[i].scene;
+        switch (stack->pending[i].type) {
+        case SCENE_OP_PUSH:
+            if (stack->depth >= MAX_SCENES) {
+                fprintf(stderr, "Erreur : pile de scenes pleine (%s)\n", scene->name);
+                break;
+            }
+            if (topScene(stack) && topScene(stack)->suspend)
+                topScene(stack)->suspend(topScene(stack));
+            enterScene(stack, scene);
+            break;
+        case SCENE_OP_POP:
+            if (stack->depth == 0)
+                break;
+            leaveScene(stack);
+            if (topScene(stack) && topScene(stack)->resume)
+                topScene(stack)->resume(topScene(stack));
+            break;
+        case SCENE_OP_SWITCH:
+            if (stack->depth > 0)
+                leaveScene(stack);
+            enterScene(stack, scene);
+            break;
+        }
+    }
+    stack->pendingCount = 0;
+}
+
+static void queueOp(SceneStack *stack, SceneOpType type, Scene *scene) {
+    if (stack->pendingCount >= MAX_SCENES) {
+        fprintf(stderr, "Erreur : trop de changements de scene en attente\n");
+        return;
+    }
+    stack->pending[stack->pendingCount].type = type;
+    stack->pending[stack->pendingCount].scene = scene;
+    stack->pendingCount++;
+}
+
+void initSceneStack(SceneStack *stack, SDL_Surface *screen) {
+    memset(stack, 0, sizeof(*stack));
+    initCompositor(&stack->compositor, screen);
+    initFrameLoop(&stack->loop, SCENE_UPDATE_HZ, SCENE_TARGET_FPS);
+}
+
+// Loads a scene's resources ahead of its first push.
+void preloadScene(SceneStack *stack, Scene *scene) {
+    rememberScene(stack, scene);
+    if (scene->loaded)
+        return;
+    Uint32 start = SDL_GetTicks();
+    if (scene->load)
+        scene->load(scene);
+    scene->loaded = 1;
+    printf("Scene %s loaded in %u ms\n", scene->name, SDL_GetTicks() - start);
+}
+
+void pushScene(SceneStack *stack, Scene *scene) {
+    queueOp(stack, SCENE_OP_PUSH, scene);
+}
+
+void popScene(SceneStack *stack) {
+    queueOp(stack, SCENE_OP_POP, NULL);
+}
+
+void switchScene(SceneStack *stack, Scene *scene) {
+    queueOp(stack, SCENE_OP_SWITCH, scene);
+}
+
+void quitScenes(SceneStack *stack) {
+    stack->quit = 1;
+}
+
+void runScenes(SceneStack *stack) {
+    SDL_Surface *screen = stack->compositor.screen;
+    FrameLoop *loop = &stack->loop;
+
+    applyPending(stack);
+    while (!stack->quit && stack->depth > 0) {
+        int steps = beginFrame(loop);
+        Scene *scene = topScene(stack);
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_QUIT) {
+                stack->quit = 1;
+                break;
+            }
+            if (scene->handleEvent && !isWakeEvent(&event))
+                scene->handleEvent(scene, &event);
+        }
+        applyPending(stack);
+        if (stack->quit || stack->depth == 0)
+            break;
+
+        for (int i = 0; i < steps && stack->pendingCount == 0; i++) {
+            scene = topScene(stack);
+            Uint32 start = SDL_GetTicks();
+            if (scene->update)
+                scene->update(scene, loop->stepMs);
+            scene->updateMs += SDL_GetTicks() - start;
+            scene->updates++;
+        }
+        applyPending(stack);
+        if (stack->depth == 0)
+            break;
+
+        scene = topScene(stack);
+        int rendered = getDirtyCount(&stack->compositor) > 0;
+        Uint32 start = SDL_GetTicks();
+        for (int r = 0; r < getDirtyCount(&stack->compositor); r++) {
+            clipToDirty(&stack->compositor, r);
+            if (scene->render)
+                scene->render(scene, screen);
+        }
+        if (rendered) {
+            scene->renderMs += SDL_GetTicks() - start;
+            scene->renders++;
+        }
+        presentDirty(&stack->compositor);
+        endFrame(loop);
+
+        // Nothing changed after a real update: sleep until input or the
+        // scene's next timed change instead of spinning.
+        if (!rendered && steps > 0 && scene->idleTimeout)
+            idleFrameLoop(loop, scene->idleTimeout(scene));
+    }
+}
+
+// Interpolation factor for render hooks that draw between two steps.
+float getSceneAlpha(const SceneStack *stack) {
+    return getFrameAlpha(&stack->loop);
+}
+
+void printSceneProfile(const SceneStack *stack) {
+    printf("%-12s %10s %10s %10s %10s\n", "scene", "updates", "update ms", "renders", "render ms");
+    for (int i = 0; i < stack->knownCount; i++) {
+        const Scene *scene = stack->known[i];
+        printf("%-12s %10lu %10u %10lu %10u\n", scene->name, scene->updates, scene->updateMs,
+               scene->renders, scene->renderMs);
+    }
+    printFrameStats(&stack->loop);
+}
+
+// Exits whatever is still on the stack, then unloads every scene once.
+void freeSceneStack(SceneStack *stack) {
+    stack->pendingCount = 0;
+    while (stack->depth > 0)
+        leaveScene(stack);
+    for (int i = 0; i < stack->knownCount; i++) {
+        Scene *scene = stack->known[i];
+        if (scene->loaded && scene->unload)
+            scene->unload(scene);
+        scene->loaded = 0;
+    }
+    stack->knownCount = 0;
+}
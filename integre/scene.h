@@ -0,0 +1,72 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <SDL/SDL.h>
+#include "compositor.h"
+#include "frameloop.h"
+
+#define MAX_SCENES 8
+#define SCENE_UPDATE_HZ 60   // Fixed update rate
+#define SCENE_TARGET_FPS 60  // Render pacing, 0 = as fast as possible
+
+typedef struct Scene Scene;
+typedef struct SceneStack SceneStack;
+
+// Every hook is optional. load/unload bracket the scene's resources and
+// run at most once each; enter/exit run on push/pop; suspend/resume run
+// when another scene is pushed on top of it or popped off again.
+struct Scene {
+    const char *name;
+    void *data;
+    SceneStack *stack;     // Set while the scene is on a stack
+    void (*load)(Scene *self);
+    void (*unload)(Scene *self);
+    void (*enter)(Scene *self);
+    void (*exit)(Scene *self);
+    void (*suspend)(Scene *self);
+    void (*resume)(Scene *self);
+    void (*handleEvent)(Scene *self, SDL_Event *event);
+    void (*update)(Scene *self, Uint32 dtMs);
+    void (*render)(Scene *self, SDL_Surface *screen);  // Called once per dirty region; see getSceneAlpha
+    // How long the scene can sleep when a frame changed nothing: 0 keeps the
+    // loop running, FRAME_WAIT_INPUT waits for input only. Without this hook
+    // the scene never idles.
+    Uint32 (*idleTimeout)(Scene *self);
+    int loaded;
+    // Profiling
+    unsigned long updates;
+    unsigned long renders;
+    Uint32 updateMs;
+    Uint32 renderMs;
+};
+
+typedef enum {
+    SCENE_OP_PUSH,
+    SCENE_OP_POP,
+    SCENE_OP_SWITCH
+} SceneOpType;
+
+struct SceneStack {
+    Scene *scenes[MAX_SCENES];
+    int depth;
+    struct { SceneOpType type; Scene *scene; } pending[MAX_SCENES];
+    int pendingCount;      // Stack changes wait for the end of the current hook
+    int quit;
+    Compositor compositor;
+    FrameLoop loop;
+    Scene *known[MAX_SCENES * 2];   // Every scene loaded so far, for unload and the profile
+    int knownCount;
+};
+
+void initSceneStack(SceneStack *stack, SDL_Surface *screen);
+void preloadScene(SceneStack *stack, Scene *scene);
+void pushScene(SceneStack *stack, Scene *scene);
+void popScene(SceneStack *stack);
+void switchScene(SceneStack *stack, Scene *scene);
+void quitScenes(SceneStack *stack);
+void runScenes(SceneStack *stack);
+float getSceneAlpha(const SceneStack *stack);
+void printSceneProfile(const SceneStack *stack);
+void freeSceneStack(SceneStack *stack);
+
+#endif // SCENE_H
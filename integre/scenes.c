@@ -0,0 +1,569 @@
+#include "scenes.h"
+#include "assets.h"
+#include "tilecache.h"
+#include "proctiles.h"
+#include "pak.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void initScene(Scene *scene, const char *name, void *data) {
+    memset(scene, 0, sizeof(*scene));
+    scene->name = name;
+    scene->data = data;
+}
+
+// Picks up assets finished by the preloader threads, whatever scene is active.
+static void pollAppPreloads(QuizApp *app, SceneStack *stack) {
+    if (isPreloadDone(&app->preloader) || !pollPreloader(&app->preloader))
+        return;
+    if (!app->background && isPreloadReady(&app->preloader, app->backgroundItem))
+        app->background = acquireOpaqueImage("bg.jpeg");
+    if (!app->scaledWin) app->scaledWin = takePreloaded(&app->preloader, app->winItem);
+    if (!app->scaledLose) app->scaledLose = takePreloaded(&app->preloader, app->loseItem);
+    collectEnginePreloads(app->engine, &app->preloader);
+    if (isPreloadDone(&app->preloader))
+        printPreloadTimings(&app->preloader);
+    markAllDirty(&stack->compositor);
+}
+
+// The hovered image is larger than the normal one: redraw what either covers.
+static void markButtonDirty(QuizApp *app, SceneStack *stack, int i) {
+    markDirty(&stack->compositor, app->normalButtons[i].rect);
+    markDirty(&stack->compositor, app->hoveredButtons[i].rect);
+}
+
+// Hover follows the top-most enabled button under the mouse: play the
+// hover sound and redraw both states.
+static void updateHover(QuizApp *app, SceneStack *stack) {
+    int hovered = hitTest(&app->buttonHits, app->mouseX, app->mouseY);
+    if (hovered == NO_HIT)
+        hovered = NO_HOVER;
+    if (hovered == app->hovered)
+        return;
+    if (hovered != NO_HOVER)
+        playSound(app->engine, SOUND_HOVER);
+    if (app->hovered != NO_HOVER) markButtonDirty(app, stack, app->hovered);
+    if (hovered != NO_HOVER) markButtonDirty(app, stack, hovered);
+    app->hovered = hovered;
+}
+
+// Only buttons first..last can be hovered or clicked.
+static void showButtons(QuizApp *app, SceneStack *stack, int first, int last) {
+    setHitRangeEnabled(&app->buttonHits, 0, NUM_BUTTONS - 1, 0);
+    setHitRangeEnabled(&app->buttonHits, first, last, 1);
+    app->hovered = NO_HOVER;
+    updateHover(app, stack);
+}
+
+// Mouse tracking and the keys every quiz-side scene shares.
+static void handleCommonEvent(QuizApp *app, SceneStack *stack, SDL_Event *event) {
+    if (event->type == SDL_MOUSEMOTION) {
+        app->mouseX = event->motion.x;
+        app->mouseY = event->motion.y;
+        updateHover(app, stack);
+    }
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_ESCAPE)
+        quitScenes(stack);
+}
+
+static void drawButton(QuizApp *app, SDL_Surface *screen, int i) {
+    ButtonImg *btn = (i == app->hovered) ? &app->hoveredButtons[i] : &app->normalButtons[i];
+    SDL_Rect pos = btn->rect;
+    SDL_BlitSurface(btn->image, NULL, screen, &pos);
+    if (btn->textSurface) {
+        SDL_Rect textPos = btn->textRect;
+        SDL_BlitSurface(btn->textSurface, NULL, screen, &textPos);
+    }
+}
+
+/* ---- Menu ---- */
+
+static const Uint32 loadingStops[] = {0xFFFFFFFF};
+static Gradient loadingGradient;
+
+static void menuEnter(Scene *self) {
+    QuizApp *app = self->data;
+    showButtons(app, self->stack, 0, 1);
+}
+
+static void menuHandleEvent(Scene *self, SDL_Event *event) {
+    QuizApp *app = self->data;
+    handleCommonEvent(app, self->stack, event);
+    // One push per batch of events: a double click must not stack two scenes.
+    if (event->type != SDL_MOUSEBUTTONDOWN || self->stack->pendingCount ||
+        event->button.button == SDL_BUTTON_WHEELUP || event->button.button == SDL_BUTTON_WHEELDOWN)
+        return;
+    int clicked = hitTest(&app->buttonHits, event->button.x, event->button.y);
+    if (clicked == 0)
+        pushScene(self->stack, &app->quizScene);
+    else if (clicked == 1)
+        pushScene(self->stack, &app->puzzleScene);
+}
+
+// Scales one puzzle tile decoded by the preloader, so the menu never
+// spends more than one rotozoom in a step. Returns 0 when none is waiting.
+static int scalePreloadedTile(QuizApp *app) {
+    for (int i = 0; i < MEMORY_IMAGE_COUNT; i++) {
+        SDL_Surface *decoded = takePreloaded(&app->preloader, app->tileItems[i]);
+        if (decoded) {
+            adoptScaledTile(app->tilePaths[i], TILE_SIZE, decoded);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void menuUpdate(Scene *self, Uint32 dtMs) {
+    QuizApp *app = self->data;
+    pollAppPreloads(app, self->stack);
+    if (scalePreloadedTile(app))
+        return;
+    // Every tile is cached by now: loading the puzzle scene is only lookups.
+    if (isPreloadDone(&app->preloader) && !app->puzzleScene.loaded)
+        preloadScene(self->stack, &app->puzzleScene);
+}
+
+static void menuRender(Scene *self, SDL_Surface *screen) {
+    QuizApp *app = self->data;
+    SDL_FillRect(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
+    SDL_BlitSurface(app->background, NULL, screen, NULL);
+    for (int i = 0; i < 2; i++)
+        drawButton(app, screen, i);
+
+    // Loading progress while the preloader is still running
+    if (!isPreloadDone(&app->preloader)) {
+        SDL_Rect track = {200, 560, 400, 12};
+        if (!loadingGradient.stopCount)
+            initGradient(&loadingGradient, loadingStops, 1);
+        drawProgressBar(screen, &loadingGradient, track, getPreloadProgress(&app->preloader),
+                        SDL_MapRGB(screen->format, 60, 60, 60), 0);
+    }
+}
+
+// The loading bar animates until the preloader is done; after that only
+// input changes the menu.
+static Uint32 menuIdleTimeout(Scene *self) {
+    QuizApp *app = self->data;
+    return isPreloadDone(&app->preloader) ? FRAME_WAIT_INPUT : 0;
+}
+
+static void menuResume(Scene *self) {
+    QuizApp *app = self->data;
+    showButtons(app, self->stack, 0, 1);
+}
+
+/* ---- Quiz ---- */
+
+static void nextQuestion(QuizSceneData *quiz) {
+    QuizApp *app = quiz->app;
+    // Between questions nothing points into the bank: take a saved edit.
+    if (takeReloadedBank(&app->questionWatcher, &app->questions, &app->questionOrder))
+        printf("Questions reloaded: %d questions\n", app->questions.count);
+    int id = drawSample(&app->questionOrder);
+    quiz->current = (id >= 0 && getBankQuestion(&app->questions, id, &quiz->question)) ? &quiz->question : NULL;
+    if (quiz->current) {
+        updateAnswerButtons(app->normalButtons, app->hoveredButtons, quiz->current->answers, app->engine->font);
+        quiz->state.startUs = gameClockUs();
+    }
+}
+
+static void endQuiz(Scene *self, int won) {
+    QuizSceneData *quiz = self->data;
+    QuizApp *app = quiz->app;
+    Mix_HaltMusic();
+    playSound(app->engine, won ? SOUND_QUIZ_WIN : SOUND_QUIZ_LOSE);
+    app->end.won = won;
+    app->end.score = quiz->state.score;
+    printResponseStats(&quiz->responses);
+    if (quiz->responses.count && !appendResponseLog(&quiz->responses, RESPONSE_LOG_FILE))
+        fprintf(stderr, "Erreur : impossible d'ecrire %s\n", RESPONSE_LOG_FILE);
+    switchScene(self->stack, &app->endScene);
+}
+
+static void quizEnter(Scene *self) {
+    QuizSceneData *quiz = self->data;
+    QuizApp *app = quiz->app;
+    quiz->state = (GameState){0, 3, 1, TOTAL_QUIZ_TIME, TOTAL_QUIZ_US, 0};
+    quiz->answered = 0;
+    quiz->responses.count = 0;
+    quiz->shownStatus[0] = '\0';
+    showButtons(app, self->stack, 2, 4);
+    // Questions carry over between rounds; start over only when too few
+    // are left for a whole round without repeats.
+    if (app->questionOrder.remaining < QUIZ_ROUND_QUESTIONS)
+        resetSampler(&app->questionOrder);
+    nextQuestion(quiz);
+    if (app->engine->music) Mix_PlayMusic(app->engine->music, -1);
+}
+
+static void quizHandleEvent(Scene *self, SDL_Event *event) {
+    QuizSceneData *quiz = self->data;
+    QuizApp *app = quiz->app;
+    handleCommonEvent(app, self->stack, event);
+    if (event->type != SDL_MOUSEBUTTONDOWN || !quiz->current || self->stack->pendingCount)
+        return;
+
+    int answerSelected = hitTest(&app->buttonHits, event->button.x, event->button.y);
+    if (answerSelected >= 2 && answerSelected <= 4) {
+        Question *q = quiz->current;
+        ResponseRecord response = {q->id, q->category, q->difficulty, 0, gameClockUs() - quiz->state.startUs};
+        response.correct = checkAnswer(q, answerSelected - 2, &quiz->state, response.responseUs);
+        recordResponse(&quiz->responses, &response);
+        quiz->answered++;
+        if (quiz->answered >= QUIZ_ROUND_QUESTIONS || quiz->answered >= app->questions.count)
+            endQuiz(self, 1);
+        else
+            nextQuestion(quiz);
+        markAllDirty(&self->stack->compositor);
+    }
+}
+
+static void quizUpdate(Scene *self, Uint32 dtMs) {
+    QuizSceneData *quiz = self->data;
+    QuizApp *app = quiz->app;
+    Compositor *compositor = &self->stack->compositor;
+    pollAppPreloads(app, self->stack);
+
+    updateGameState(&quiz->state);
+    if (quiz->state.timeLeft <= 0 || quiz->state.lives <= 0) {
+        endQuiz(self, 0);
+        return;
+    }
+    float timeRatio = (float)((double)quiz->state.timeLeftUs / (double)TOTAL_QUIZ_US);
+    SDL_Rect changed;
+    if (updateTimerBar(&app->gameTimer, timeRatio, &changed))
+        markDirty(compositor, changed);
+
+    char statusText[50];
+    sprintf(statusText, "Score: %d Lives: %d", quiz->state.score, quiz->state.lives);
+    if (strcmp(statusText, quiz->shownStatus) != 0) {
+        int w, h;
+        if (TTF_SizeText(app->engine->font, quiz->shownStatus, &w, &h) == 0)
+            markDirty(compositor, (SDL_Rect){10, 10, w, h});
+        if (TTF_SizeText(app->engine->font, statusText, &w, &h) == 0)
+            markDirty(compositor, (SDL_Rect){10, 10, w, h});
+        strcpy(quiz->shownStatus, statusText);
+    }
+}
+
+// Sleep until the timer bar's edge moves by one step.
+static Uint32 quizIdleTimeout(Scene *self) {
+    QuizSceneData *quiz = self->data;
+    if (!isPreloadDone(&quiz->app->preloader))
+        return 0;
+    return timerBarNextChangeMs(&quiz->app->gameTimer, quiz->state.timeLeftUs, TOTAL_QUIZ_US);
+}
+
+static void quizRender(Scene *self, SDL_Surface *screen) {
+    QuizSceneData *quiz = self->data;
+    QuizApp *app = quiz->app;
+    SDL_FillRect(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
+    SDL_BlitSurface(app->background, NULL, screen, NULL);
+    renderTimerBar(screen, &app->gameTimer);
+
+    // The glyph atlas only holds ASCII; other text goes through the text cache.
+    if (quiz->current && isAsciiView(quiz->current->question))
+        drawAtlasText(screen, &app->textAtlas, quiz->current->question.text, 100, 100);
+    else if (quiz->current)
+        drawCachedText(screen, &gTextCache, app->engine->font, (SDL_Color){255, 255, 255},
+                       quiz->current->question.text, 100, 100);
+
+    // Display score and lives
+    drawCachedText(screen, &gTextCache, app->engine->font, (SDL_Color){255, 255, 255}, quiz->shownStatus, 10, 10);
+
+    for (int j = 2; j < NUM_BUTTONS; j++)
+        drawButton(app, screen, j);
+}
+
+/* ---- End screen ---- */
+
+static void endEnter(Scene *self) {
+    EndSceneData *end = self->data;
+    end->alpha = 0.0f;
+}
+
+static void endHandleEvent(Scene *self, SDL_Event *event) {
+    EndSceneData *end = self->data;
+    handleCommonEvent(end->app, self->stack, event);
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_r) {
+        // Back to the menu, which was only suspended.
+        Mix_HaltMusic();
+        popScene(self->stack);
+    }
+}
+
+static void endUpdate(Scene *self, Uint32 dtMs) {
+    EndSceneData *end = self->data;
+    pollAppPreloads(end->app, self->stack);
+    // Fade animation
+    if (end->alpha < 1.0f) {
+        end->alpha += 0.02f;
+        if (end->alpha > 1.0f) end->alpha = 1.0f;
+        markAllDirty(&self->stack->compositor);
+    }
+}
+
+static Uint32 endIdleTimeout(Scene *self) {
+    EndSceneData *end = self->data;
+    return (end->alpha < 1.0f || !isPreloadDone(&end->app->preloader)) ? 0 : FRAME_WAIT_INPUT;
+}
+
+static void endRender(Scene *self, SDL_Surface *screen) {
+    EndSceneData *end = self->data;
+    QuizApp *app = end->app;
+    SDL_FillRect(screen, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
+
+    SDL_Surface *endScreen = end->won ? app->scaledWin : app->scaledLose;
+    if (endScreen) {
+        SDL_SetAlpha(endScreen, SDL_SRCALPHA, (Uint8)(end->alpha * 255));
+        SDL_BlitSurface(endScreen, NULL, screen, NULL);
+    }
+
+    // Display score
+    char scoreText[50];
+    sprintf(scoreText, "Score: %d", end->score);
+    drawAtlasText(screen, &app->textAtlas, scoreText, 350, 400);
+
+    // Display restart prompt
+    drawAtlasText(screen, &app->textAtlas, "Press R to Restart", 350, 450);
+}
+
+/* ---- Memory puzzle ---- */
+
+static void startPuzzleRound(Scene *self) {
+    PuzzleSceneData *puzzle = self->data;
+    int grid_size;
+    if (puzzle->large)
+        grid_size = MEMORY_LARGE_BOARD;
+    else if (puzzle->difficulty == 1)
+        grid_size = 2;
+    else if (puzzle->difficulty == 2)
+        grid_size = 4;
+    else // difficulty == 3
+        grid_size = 4;
+
+    initialiser_enigme(&puzzle->game, ".", grid_size, puzzle->difficulty); // Use current directory for assets
+    puzzle->game.compositor = &self->stack->compositor;
+    markAllDirty(&self->stack->compositor);
+}
+
+// Scales the tiles into the tile cache so the first round starts at once.
+// Normally a cache hit for every tile (see scalePreloadedTile); decodes
+// here only if the puzzle is opened before the preloader got to them.
+static void puzzleLoad(Scene *self) {
+    PuzzleSceneData *puzzle = self->data;
+    for (int i = 0; i < MEMORY_IMAGE_COUNT; i++)
+        getScaledTile(puzzle->app->tilePaths[i], TILE_SIZE);
+}
+
+static void puzzleEnter(Scene *self) {
+    PuzzleSceneData *puzzle = self->data;
+    Engine *engine = puzzle->app->engine;
+
+    // Borrow the font and sounds from the engine; nothing is opened here.
+    gFont = engine->titleFont;
+    flipSound = getSound(engine, SOUND_FLIP);
+    matchSound = getSound(engine, SOUND_MATCH);
+    wrongSound = getSound(engine, SOUND_WRONG);
+    winSound = getSound(engine, SOUND_PUZZLE_WIN);
+    loseSound = getSound(engine, SOUND_PUZZLE_LOSE);
+
+    // Set difficulty (default to 3 for Extreme, as in original)
+    puzzle->difficulty = 3;
+    puzzle->large = 0;
+    startPuzzleRound(self);
+}
+
+static void puzzleHandleEvent(Scene *self, SDL_Event *event) {
+    PuzzleSceneData *puzzle = self->data;
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_q) {
+        popScene(self->stack);
+        return;
+    }
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_r) {
+        Memory_Cleanup(&puzzle->game);
+        startPuzzleRound(self);
+        return;
+    }
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_l) {
+        // Large board: generated tiles, arrows/drag to scroll, +/-/wheel to zoom
+        puzzle->large = !puzzle->large;
+        Memory_Cleanup(&puzzle->game);
+        startPuzzleRound(self);
+        return;
+    }
+    if (event->type == SDL_KEYDOWN && event->key.keysym.sym == SDLK_d) {
+        puzzle->difficulty = 1;
+        printf("Difficulty reset to level 1 (2x2)\n");
+    }
+    Memory_HandleEvent(&puzzle->game, event);
+}
+
+static void puzzleUpdate(Scene *self, Uint32 dtMs) {
+    PuzzleSceneData *puzzle = self->data;
+    pollAppPreloads(puzzle->app, self->stack);
+    Memory_Update(&puzzle->game);
+}
+
+static void puzzleRender(Scene *self, SDL_Surface *screen) {
+    PuzzleSceneData *puzzle = self->data;
+    Memory_Render(&puzzle->game, screen);
+}
+
+// The clock and the preview end on whole seconds from the start of the
+// round; a mismatched pair must be flipped back on time, so stay awake.
+static Uint32 puzzleIdleTimeout(Scene *self) {
+    MemoryGame *game = &((PuzzleSceneData *)self->data)->game;
+    if (game->game_over)
+        return FRAME_WAIT_INPUT;
+    if (game->selected[0] != -1 && game->selected[1] != -1)
+        return 0;
+    return 1000 - (SDL_GetTicks() - game->start_time) % 1000;
+}
+
+static void puzzleExit(Scene *self) {
+    PuzzleSceneData *puzzle = self->data;
+    Memory_Cleanup(&puzzle->game);
+    freeProceduralTiles();
+    // Persist newly scaled tiles; the font and sounds stay with the engine.
+    saveTileCache(TILE_CACHE_FILE);
+}
+
+/* ---- Setup ---- */
+
+int initQuizApp(QuizApp *app, Engine *engine) {
+    SDL_Surface *screen = engine->screen;
+    TTF_Font *font = engine->font;
+
+    memset(app, 0, sizeof(*app));
+    app->engine = engine;
+    app->hovered = NO_HOVER;
+
+    if (!loadQuestionBank(&app->questions, QBANK_FILE, QUESTION_TEXT_FILE)) {
+        printf("Failed to load questions\n");
+        return 0;
+    }
+    Uint64 seed = ((Uint64)rand() << 32) ^ (Uint64)rand();
+    if (!initBankSampler(&app->questionOrder, &app->questions, SAMPLE_BY_CATEGORY, seed)) {
+        printf("Failed to set up question sampling\n");
+        closeQuestionBank(&app->questions);
+        return 0;
+    }
+    startBankWatcher(&app->questionWatcher, QUESTION_TEXT_FILE, SAMPLE_BY_CATEGORY, seed);
+
+    if (!initGlyphAtlas(&app->textAtlas, font, (SDL_Color){255, 255, 255})) {
+        printf("Failed to build glyph atlas\n");
+    }
+    app->textAtlas.surface = optimizeSurface(app->textAtlas.surface, 0);
+
+    // Packed sprites (tools/pack_atlas.c) replace the individual files when
+    // present; anything missing from the atlas still loads on its own.
+    if (loadSpriteAtlas(&app->sprites, SPRITE_ATLAS_FILE)) {
+        adoptAtlasSprites(&app->sprites);
+        for (int i = 0; i < app->sprites.count; i++) {
+            AtlasSprite *s = &app->sprites.sprites[i];
+            if (s->view && s->entry.tileSize) {
+                storeScaledTile(s->entry.name, s->entry.tileSize, s->view);
+                s->view = NULL;
+            }
+        }
+    }
+
+    // Decode the large assets on worker threads so the menu shows at once.
+    // Images and sounds end up in the asset manager as they become ready.
+    initPreloader(&app->preloader);
+    app->backgroundItem = addPreload(&app->preloader, "bg.jpeg", PRELOAD_OPAQUE_IMAGE);
+    app->winItem = addStretchedPreload(&app->preloader, "win.png", 800, 600);
+    app->loseItem = addStretchedPreload(&app->preloader, "lose.png", 800, 600);
+    queueEnginePreloads(engine, &app->preloader);
+    // Puzzle tiles missing from the tile cache and the atlas: decode them
+    // here too and scale them from the menu, one per step.
+    for (int i = 0; i < MEMORY_IMAGE_COUNT; i++) {
+        Memory_TilePath(app->tilePaths[i], sizeof(app->tilePaths[i]), ".", i);
+        app->tileItems[i] = -1;
+        if (!hasScaledTile(app->tilePaths[i], TILE_SIZE) && assetMtime(app->tilePaths[i]) >= 0)
+            app->tileItems[i] = addPreload(&app->preloader, app->tilePaths[i], PRELOAD_DECODED_IMAGE);
+    }
+    startPreloader(&app->preloader);
+
+    initTimerBar(&app->gameTimer, "timer_bar.png", 50, 50, screen);
+
+    // Initialize buttons (adjusted positions for larger window)
+    initialiser_bouton(&app->normalButtons[0], "quiz.png", 200, 200, NULL, NULL);
+    initialiser_bouton(&app->normalButtons[1], "puzzle.png", 450, 200, NULL, NULL);
+    initialiser_bouton(&app->normalButtons[2], "reponse_a.png", 100, 150, "Answer 1", font);
+    initialiser_bouton(&app->normalButtons[3], "reponse_b.png", 300, 150, "Answer 2", font);
+    initialiser_bouton(&app->normalButtons[4], "reponse_c.png", 500, 150, "Answer 3", font);
+
+    initialiser_bouton(&app->hoveredButtons[0], "quizl.png", 200, 200, NULL, NULL);
+    initialiser_bouton(&app->hoveredButtons[1], "puzzlel.png", 450, 200, NULL, NULL);
+    initialiser_bouton(&app->hoveredButtons[2], "reponse_al.png", 100, 150, NULL, NULL);
+    initialiser_bouton(&app->hoveredButtons[3], "reponse_bl.png", 300, 150, NULL, NULL);
+    initialiser_bouton(&app->hoveredButtons[4], "reponse_cl.png", 500, 150, NULL, NULL);
+    for (int i = 2; i < NUM_BUTTONS; i++) {
+        // Same label on both states: render it once and share the surface.
+        app->hoveredButtons[i].textSurface = app->normalButtons[i].textSurface;
+        app->hoveredButtons[i].textRect = app->normalButtons[i].textRect;
+    }
+    initHitIndex(&app->buttonHits, screen->w, screen->h, HIT_CELL_SIZE);
+    for (int i = 0; i < NUM_BUTTONS; i++)
+        addHitWidget(&app->buttonHits, i, app->normalButtons[i].rect, i);
+
+    initScene(&app->menuScene, "menu", app);
+    app->menuScene.enter = menuEnter;
+    app->menuScene.resume = menuResume;
+    app->menuScene.handleEvent = menuHandleEvent;
+    app->menuScene.update = menuUpdate;
+    app->menuScene.render = menuRender;
+    app->menuScene.idleTimeout = menuIdleTimeout;
+
+    app->quiz.app = app;
+    initScene(&app->quizScene, "quiz", &app->quiz);
+    app->quizScene.enter = quizEnter;
+    app->quizScene.handleEvent = quizHandleEvent;
+    app->quizScene.update = quizUpdate;
+    app->quizScene.render = quizRender;
+    app->quizScene.idleTimeout = quizIdleTimeout;
+
+    app->end.app = app;
+    initScene(&app->endScene, "end", &app->end);
+    app->endScene.enter = endEnter;
+    app->endScene.handleEvent = endHandleEvent;
+    app->endScene.update = endUpdate;
+    app->endScene.render = endRender;
+    app->endScene.idleTimeout = endIdleTimeout;
+
+    app->puzzle.app = app;
+    initScene(&app->puzzleScene, "puzzle", &app->puzzle);
+    app->puzzleScene.load = puzzleLoad;
+    app->puzzleScene.enter = puzzleEnter;
+    app->puzzleScene.exit = puzzleExit;
+    app->puzzleScene.handleEvent = puzzleHandleEvent;
+    app->puzzleScene.update = puzzleUpdate;
+    app->puzzleScene.render = puzzleRender;
+    app->puzzleScene.idleTimeout = puzzleIdleTimeout;
+    return 1;
+}
+
+void freeQuizApp(QuizApp *app) {
+    for (int i = 0; i < NUM_BUTTONS; i++) {
+        releaseAsset(app->normalButtons[i].image);
+        releaseAsset(app->hoveredButtons[i].image);
+        if (app->hoveredButtons[i].textSurface &&
+            app->hoveredButtons[i].textSurface != app->normalButtons[i].textSurface)
+            SDL_FreeSurface(app->hoveredButtons[i].textSurface);
+        if (app->normalButtons[i].textSurface) SDL_FreeSurface(app->normalButtons[i].textSurface);
+    }
+
+    freePreloader(&app->preloader);
+    releaseAsset(app->background);
+    SDL_FreeSurface(app->scaledWin);
+    SDL_FreeSurface(app->scaledLose);
+    freeTimerBar(&app->gameTimer);
+    freeGlyphAtlas(&app->textAtlas);
+    freeHitIndex(&app->buttonHits);
+    freeSpriteAtlas(&app->sprites);
+    stopBankWatcher(&app->questionWatcher);
+    freeSampler(&app->questionOrder);
+    closeQuestionBank(&app->questions);
+}
@@ -0,0 +1,77 @@
+#ifndef SCENES_H
+#define SCENES_H
+
+#include "header.h"
+#include "enigme2.h"
+#include "glyphatlas.h"
+#include "preload.h"
+#include "engine.h"
+#include "scene.h"
+#include "hittest.h"
+#include "spriteatlas.h"
+#include "qbank.h"
+#include "sampler.h"
+#include "qwatch.h"
+#include "gameclock.h"
+
+typedef struct QuizApp QuizApp;
+
+typedef struct {
+    QuizApp *app;
+    GameState state;
+    Question question;
+    Question *current;     // &question, or NULL once the bank runs out
+    int answered;
+    ResponseLog responses; // Timing of each answer this round
+    char shownStatus[50];
+} QuizSceneData;
+
+typedef struct {
+    QuizApp *app;
+    int won;
+    int score;
+    float alpha;
+} EndSceneData;
+
+typedef struct {
+    QuizApp *app;
+    MemoryGame game;
+    int difficulty;
+    int large;             // Toggled with L
+} PuzzleSceneData;
+
+// Resources shared by the menu, quiz, end and puzzle scenes.
+struct QuizApp {
+    Engine *engine;
+    GlyphAtlas textAtlas;
+    SpriteAtlas sprites;           // Buttons, timer bar and memory tiles in one load
+    Preloader preloader;
+    int backgroundItem, winItem, loseItem;
+    char tilePaths[MEMORY_IMAGE_COUNT][32];
+    int tileItems[MEMORY_IMAGE_COUNT];    // Puzzle tiles decoded by the preloader, -1 if cached
+    SDL_Surface *background;
+    SDL_Surface *scaledWin;
+    SDL_Surface *scaledLose;
+    QuestionBank questions;
+    Sampler questionOrder;         // No repeats until the whole bank was asked
+    BankWatcher questionWatcher;   // Edits to the question file, compiled off-thread
+    TimerBar gameTimer;
+    ButtonImg normalButtons[NUM_BUTTONS];
+    ButtonImg hoveredButtons[NUM_BUTTONS];
+    HitIndex buttonHits;   // Button ids are their indices
+    int hovered;
+    int mouseX, mouseY;
+
+    Scene menuScene;
+    Scene quizScene;
+    Scene endScene;
+    Scene puzzleScene;
+    QuizSceneData quiz;
+    EndSceneData end;
+    PuzzleSceneData puzzle;
+};
+
+int initQuizApp(QuizApp *app, Engine *engine);
+void freeQuizApp(QuizApp *app);
+
+#endif // SCENES_H
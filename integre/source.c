@@ -1,23 +1,13 @@
 #include "header.h"
+#include "assets.h"
+#include "gameclock.h"
 #include <stdlib.h>
 #include <string.h>
 
-int getHoveredButtonAt(ButtonImg buttons[], int numButtons, int mouseX, int mouseY) {
-    for (int i = 0; i < numButtons; i++) {
-        if (mouseX >= buttons[i].rect.x &&
-            mouseX <= (buttons[i].rect.x + buttons[i].rect.w) &&
-            mouseY >= buttons[i].rect.y &&
-            mouseY <= (buttons[i].rect.y + buttons[i].rect.h)) {
-            return i;
-        }
-    }
-    return NO_HOVER;
-}
-
 void initialiser_bouton(ButtonImg *btn, const char *chemin, int x, int y, const char* text, TTF_Font* font) {
-    btn->image = IMG_Load(chemin);
+    btn->textSurface = NULL;
+    btn->image = acquireImage(chemin);
     if (btn->image == NULL) {
-        fprintf(stderr, "Erreur lors du chargement du bouton : %s\n", SDL_GetError());
         return;
     }
     btn->rect.x = x;
@@ -36,94 +26,41 @@ void initialiser_bouton(ButtonImg *btn, const char *chemin, int x, int y, const
 }
 
 void updateAnswerButtons(ButtonImg normalButtons[], ButtonImg hoveredButtons[], 
-                        const char answers[][MAX_ANSWER_LENGTH], TTF_Font* font) {
+                        const StringView answers[3], TTF_Font* font) {
     for (int i = 0; i < 3; i++) {
         int btnIndex = i + 2;
+        ButtonImg *normal = &normalButtons[btnIndex];
+        ButtonImg *hovered = &hoveredButtons[btnIndex];
         
-        if (normalButtons[btnIndex].textSurface) {
-            SDL_FreeSurface(normalButtons[btnIndex].textSurface);
+        if (hovered->textSurface && hovered->textSurface != normal->textSurface) {
+            SDL_FreeSurface(hovered->textSurface);
         }
-        if (hoveredButtons[btnIndex].textSurface) {
-            SDL_FreeSurface(hoveredButtons[btnIndex].textSurface);
+        if (normal->textSurface) {
+            SDL_FreeSurface(normal->textSurface);
         }
         
+        // Both states show the same answer: render it once and share the surface.
         SDL_Color textColor = {255, 255, 255};
-        normalButtons[btnIndex].textSurface = TTF_RenderText_Blended(font, answers[i], textColor);
-        hoveredButtons[btnIndex].textSurface = TTF_RenderText_Blended(font, answers[i], textColor);
+        normal->textSurface = TTF_RenderUTF8_Blended(font, answers[i].text, textColor);
+        hovered->textSurface = normal->textSurface;
         
-        if (normalButtons[btnIndex].textSurface) {
-            normalButtons[btnIndex].textRect.x = normalButtons[btnIndex].rect.x + 
-                (normalButtons[btnIndex].rect.w - normalButtons[btnIndex].textSurface->w) / 2;
-            normalButtons[btnIndex].textRect.y = normalButtons[btnIndex].rect.y + 
-                (normalButtons[btnIndex].rect.h - normalButtons[btnIndex].textSurface->h) / 2;
-        }
-        
-        if (hoveredButtons[btnIndex].textSurface) {
-            hoveredButtons[btnIndex].textRect.x = hoveredButtons[btnIndex].rect.x + 
-                (hoveredButtons[btnIndex].rect.w - hoveredButtons[btnIndex].textSurface->w) / 2;
-            hoveredButtons[btnIndex].textRect.y = hoveredButtons[btnIndex].rect.y + 
-                (hoveredButtons[btnIndex].rect.h - hoveredButtons[btnIndex].textSurface->h) / 2;
+        if (normal->textSurface) {
+            normal->textRect.x = normal->rect.x + (normal->rect.w - normal->textSurface->w) / 2;
+            normal->textRect.y = normal->rect.y + (normal->rect.h - normal->textSurface->h) / 2;
+            hovered->textRect.x = hovered->rect.x + (hovered->rect.w - hovered->textSurface->w) / 2;
+            hovered->textRect.y = hovered->rect.y + (hovered->rect.h - hovered->textSurface->h) / 2;
         }
     }
 }
 
-int loadQuestions(Question questions[], const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) return 0;
-
-    for (int i = 0; i < MAX_QUESTIONS; i++) {
-        if (!fgets(questions[i].question, MAX_QUESTION_LENGTH, file)) break;
-        questions[i].question[strcspn(questions[i].question, "\n")] = 0;
-        
-        char tempAnswers[3][MAX_ANSWER_LENGTH];
-        for (int j = 0; j < 3; j++) {
-            if (!fgets(tempAnswers[j], MAX_ANSWER_LENGTH, file)) break;
-            tempAnswers[j][strcspn(tempAnswers[j], "\n")] = 0;
-        }
-        
-        // Shuffle answers
-        int indices[3] = {0, 1, 2};
-        for (int j = 2; j > 0; j--) {
-            int k = rand() % (j + 1);
-            int temp = indices[j];
-            indices[j] = indices[k];
-            indices[k] = temp;
-        }
-        
-        // Assign shuffled answers and track correct answer
-        int correctIndex = 0; // Original correct answer is always first
-        for (int j = 0; j < 3; j++) {
-            strcpy(questions[i].answers[j], tempAnswers[indices[j]]);
-            if (indices[j] == 0) {
-                questions[i].correctAnswer = j;
-            }
-        }
-        
-        questions[i].used = 0;
-    }
-    
-    fclose(file);
-    return 1;
-}
-
-Question* getRandomQuestion(Question questions[]) {
-    int available = 0;
-    int indices[MAX_QUESTIONS];
-    
-    for (int i = 0; i < MAX_QUESTIONS; i++) {
-        if (!questions[i].used) indices[available++] = i;
-    }
-    
-    if (available == 0) return NULL;
-    
-    int randomIndex = indices[rand() % available];
-    questions[randomIndex].used = 1;
-    return &questions[randomIndex];
-}
-
-int checkAnswer(Question* q, int answerIndex, GameState* state) {
+int checkAnswer(Question* q, int answerIndex, GameState* state, Uint64 responseUs) {
     if (answerIndex == q->correctAnswer) {
-        state->score += 10 * state->level;
+        int points = 10 * state->level;
+        // Up to double points, shrinking linearly to nothing at FAST_ANSWER_MS.
+        Uint64 fastUs = (Uint64)FAST_ANSWER_MS * 1000;
+        if (responseUs < fastUs)
+            points += (int)(points * (fastUs - responseUs) / fastUs);
+        state->score += points;
         return 1;
     } else {
         state->lives--;
@@ -132,50 +69,103 @@ int checkAnswer(Question* q, int answerIndex, GameState* state) {
 }
 
 void initTimerBar(TimerBar* timer, const char* imagePath, int x, int y, SDL_Surface* screen) {
-    timer->fullTimer = IMG_Load(imagePath);
-    if (!timer->fullTimer) return;
+    memset(timer, 0, sizeof(*timer));
+    SDL_Surface *image = acquireImage(imagePath);
+    if (!image) return;
     
     timer->position.x = x;
     timer->position.y = y;
-    timer->position.w = timer->fullTimer->w;
-    timer->position.h = timer->fullTimer->h;
-    timer->maxWidth = timer->fullTimer->w;
+    timer->position.w = image->w;
+    timer->position.h = image->h;
+    timer->maxWidth = image->w;
+    timer->level = timer->maxWidth * TIMER_SUBPIXELS;
+    timer->trackColor = SDL_MapRGB(screen->format, 0, 0, 0);
     
-    timer->currentTimer = SDL_CreateRGBSurface(SDL_SWSURFACE, 
-                                             timer->maxWidth, 
-                                             timer->fullTimer->h, 
-                                             screen->format->BitsPerPixel,
-                                             0, 0, 0, 0);
+    // Blend the bar onto its track once: frames then copy opaque pixels
+    // instead of alpha blending the image.
+    timer->strip = SDL_CreateRGBSurface(SDL_SWSURFACE, 
+                                        timer->maxWidth, 
+                                        image->h, 
+                                        screen->format->BitsPerPixel,
+                                        screen->format->Rmask,
+                                        screen->format->Gmask,
+                                        screen->format->Bmask, 0);
+    if (timer->strip) {
+        SDL_FillRect(timer->strip, NULL, timer->trackColor);
+        SDL_BlitSurface(image, NULL, timer->strip, NULL);
+    }
+    releaseAsset(image);
+}
+
+// Returns 1, with the columns to redraw in *changed, when the filled width
+// moved since the last call. Only those columns need to reach the screen.
+int updateTimerBar(TimerBar* timer, float timeRatio, SDL_Rect* changed) {
+    int maxLevel = timer->maxWidth * TIMER_SUBPIXELS;
+    int level = (int)(maxLevel * timeRatio);
+    if (level < 0) level = 0;
+    if (level > maxLevel) level = maxLevel;
+    if (level == timer->level || !timer->strip) return 0;
     
-    timer->cropRect.x = 0;
-    timer->cropRect.y = 0;
-    timer->cropRect.w = timer->maxWidth;
-    timer->cropRect.h = timer->fullTimer->h;
+    int low = level < timer->level ? level : timer->level;
+    int high = level < timer->level ? timer->level : level;
+    int from = low / TIMER_SUBPIXELS;
+    int to = (high + TIMER_SUBPIXELS - 1) / TIMER_SUBPIXELS;
+    changed->x = timer->position.x + from;
+    changed->y = timer->position.y;
+    changed->w = to - from;
+    changed->h = timer->position.h;
+    timer->level = level;
+    return 1;
 }
 
-void updateTimerBar(TimerBar* timer, float timeRatio, SDL_Surface* screen) {
-    int newWidth = (int)(timer->maxWidth * timeRatio);
-    timer->cropRect.w = newWidth > 0 ? newWidth : 0;
-    SDL_FillRect(timer->currentTimer, NULL, SDL_MapRGB(screen->format, 0, 0, 0));
-    SDL_BlitSurface(timer->fullTimer, &timer->cropRect, timer->currentTimer, NULL);
+// How long until the bar reaches its next edge step, so idle frames can
+// sleep exactly that long.
+Uint32 timerBarNextChangeMs(const TimerBar* timer, Uint64 timeLeftUs, Uint64 totalUs) {
+    Uint64 steps = (Uint64)timer->maxWidth * TIMER_SUBPIXELS;
+    if (steps == 0 || timeLeftUs == 0)
+        return 1;
+    Uint64 level = timeLeftUs * steps / totalUs;
+    Uint64 boundaryUs = (level * totalUs + steps - 1) / steps;
+    Uint64 waitUs = timeLeftUs - boundaryUs + 1;
+    return (Uint32)((waitUs + 999) / 1000);
 }
 
+// Draws straight to the screen: the filled part, the edge column faded by
+// how much of it is covered, and the empty track.
 void renderTimerBar(SDL_Surface* screen, TimerBar* timer) {
-    SDL_BlitSurface(timer->currentTimer, NULL, screen, &timer->position);
+    if (!timer->strip) return;
+    int full = timer->level / TIMER_SUBPIXELS;
+    int fraction = timer->level % TIMER_SUBPIXELS;
+    
+    SDL_Rect track = {timer->position.x + full, timer->position.y, timer->maxWidth - full, timer->position.h};
+    SDL_FillRect(screen, &track, timer->trackColor);
+    SDL_Rect crop = {0, 0, full, timer->position.h};
+    SDL_Rect pos = timer->position;
+    SDL_BlitSurface(timer->strip, &crop, screen, &pos);
+    
+    if (fraction) {
+        SDL_Rect edge = {full, 0, 1, timer->position.h};
+        SDL_Rect edgePos = {timer->position.x + full, timer->position.y, 0, 0};
+        SDL_SetAlpha(timer->strip, SDL_SRCALPHA, (Uint8)(fraction * 255 / TIMER_SUBPIXELS));
+        SDL_BlitSurface(timer->strip, &edge, screen, &edgePos);
+        SDL_SetAlpha(timer->strip, 0, SDL_ALPHA_OPAQUE);
+    }
 }
 
 void freeTimerBar(TimerBar* timer) {
-    if (timer->fullTimer) SDL_FreeSurface(timer->fullTimer);
-    if (timer->currentTimer) SDL_FreeSurface(timer->currentTimer);
+    if (timer->strip) SDL_FreeSurface(timer->strip);
+    timer->strip = NULL;
 }
 
 void updateGameState(GameState* state) {
-    Uint32 currentTime = SDL_GetTicks();
-    Uint32 elapsedSeconds = (currentTime - state->startTime) / 1000;
-    state->timeLeft = TOTAL_QUIZ_TIME - elapsedSeconds;
+    Uint64 now = gameClockUs();
+    Uint64 totalUs = TOTAL_QUIZ_US;
+    Uint64 elapsedUs = now - state->startUs;
+    state->timeLeftUs = elapsedUs < totalUs ? totalUs - elapsedUs : 0;
+    state->timeLeft = (int)((state->timeLeftUs + 999999) / 1000000);
     
     if (state->timeLeft <= 0) {
         state->lives--;
-        state->startTime = SDL_GetTicks();
+        state->startUs = now;
     }
 }
@@ -0,0 +1,90 @@
+#include "spriteatlas.h"
+#include "assets.h"
+#include "rawimage.h"
+#include "pak.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static SDL_Surface* createView(SDL_Surface *atlas, const AtlasFileEntry *e) {
+    SDL_PixelFormat *fmt = atlas->format;
+    Uint8 *pixels = (Uint8 *)atlas->pixels + e->y * atlas->pitch + e->x * fmt->BytesPerPixel;
+    SDL_Surface *view = SDL_CreateRGBSurfaceFrom(pixels, e->w, e->h, fmt->BitsPerPixel, atlas->pitch,
+                                                 fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask);
+    if (!view)
+        return NULL;
+    // Opaque sprites are copied, the others alpha-blended.
+    if (fmt->Amask)
+        SDL_SetAlpha(view, e->opaque ? 0 : SDL_SRCALPHA, SDL_ALPHA_OPAQUE);
+    return view;
+}
+
+int loadSpriteAtlas(SpriteAtlas *atlas, const char *path) {
+    memset(atlas, 0, sizeof(*atlas));
+    FILE *fp = openAssetFile(path);
+    if (!fp)
+        return 0;
+
+    AtlasFileHeader hdr;
+    if (fread(&hdr, sizeof(hdr), 1, fp) != 1 || hdr.magic != SPRITE_ATLAS_MAGIC ||
+        hdr.version != SPRITE_ATLAS_VERSION || hdr.count == 0 || hdr.count > 4096) {
+        fprintf(stderr, "Erreur : atlas %s invalide\n", path);
+        fclose(fp);
+        return 0;
+    }
+    atlas->sprites = calloc(hdr.count, sizeof(AtlasSprite));
+    for (Uint32 i = 0; atlas->sprites && i < hdr.count; i++) {
+        if (fread(&atlas->sprites[i].entry, sizeof(AtlasFileEntry), 1, fp) != 1)
+            break;
+        atlas->sprites[i].entry.name[ATLAS_NAME_LENGTH - 1] = '\0';
+        atlas->count++;
+    }
+    SDL_Surface *pixels = (atlas->count == (int)hdr.count) ? readRawImage(fp) : NULL;
+    fclose(fp);
+    if (!pixels) {
+        fprintf(stderr, "Erreur : atlas %s tronque\n", path);
+        freeSpriteAtlas(atlas);
+        return 0;
+    }
+
+    // No RLE: the views read the pixels directly.
+    atlas->surface = optimizeSurface(pixels, 0);
+    for (int i = 0; i < atlas->count; i++) {
+        AtlasFileEntry *e = &atlas->sprites[i].entry;
+        if (e->x + e->w > atlas->surface->w || e->y + e->h > atlas->surface->h) {
+            fprintf(stderr, "Erreur : sprite %s hors de l'atlas\n", e->name);
+            continue;
+        }
+        atlas->sprites[i].view = createView(atlas->surface, e);
+    }
+    return 1;
+}
+
+const AtlasSprite* findAtlasSprite(const SpriteAtlas *atlas, const char *name) {
+    for (int i = 0; i < atlas->count; i++) {
+        if (strcmp(atlas->sprites[i].entry.name, name) == 0)
+            return &atlas->sprites[i];
+    }
+    return NULL;
+}
+
+void adoptAtlasSprites(SpriteAtlas *atlas) {
+    for (int i = 0; i < atlas->count; i++) {
+        AtlasSprite *s = &atlas->sprites[i];
+        if (s->view && s->entry.tileSize == 0) {
+            adoptAsset(ASSET_IMAGE, s->entry.name, s->view);
+            s->view = NULL;
+        }
+    }
+}
+
+void freeSpriteAtlas(SpriteAtlas *atlas) {
+    for (int i = 0; i < atlas->count; i++) {
+        if (atlas->sprites[i].view)
+            SDL_FreeSurface(atlas->sprites[i].view);
+    }
+    free(atlas->sprites);
+    if (atlas->surface)
+        SDL_FreeSurface(atlas->surface);
+    memset(atlas, 0, sizeof(*atlas));
+}
@@ -0,0 +1,47 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <SDL/SDL.h>
+
+#define SPRITE_ATLAS_FILE "sprites.atlas"
+#define SPRITE_ATLAS_MAGIC 0x4C544153  // "SATL"
+#define SPRITE_ATLAS_VERSION 1
+#define ATLAS_NAME_LENGTH 64
+
+// File layout written by tools/pack_atlas.c: a header, one entry per
+// sprite, then the packed RGBA pixels as a raw image (rawimage.h).
+typedef struct {
+    Uint32 magic;
+    Uint32 version;
+    Uint32 count;
+} AtlasFileHeader;
+
+typedef struct {
+    char name[ATLAS_NAME_LENGTH];  // Path the sprite was packed from
+    Uint16 x, y, w, h;
+    Uint16 tileSize;               // Memory tile scaled to this size, 0 for plain sprites
+    Uint16 opaque;                 // No meaningful alpha: blitted as a plain copy
+} AtlasFileEntry;
+
+typedef struct {
+    AtlasFileEntry entry;
+    SDL_Surface *view;             // Shares the atlas pixels; NULL once handed over
+} AtlasSprite;
+
+typedef struct {
+    SDL_Surface *surface;          // Display format, never RLE (views point into it)
+    AtlasSprite *sprites;
+    int count;
+} SpriteAtlas;
+
+// Sprites are exposed as surfaces that share the atlas pixels, so code
+// that blits whole surfaces keeps working while every sprite comes out of
+// one load and one block of memory. The atlas must outlive its views.
+int loadSpriteAtlas(SpriteAtlas *atlas, const char *path);
+const AtlasSprite* findAtlasSprite(const SpriteAtlas *atlas, const char *name);
+// Registers every plain sprite with the asset manager under its file
+// name, so acquireImage() of that name is served from the atlas.
+void adoptAtlasSprites(SpriteAtlas *atlas);
+void freeSpriteAtlas(SpriteAtlas *atlas);
+
+#endif // SPRITEATLAS_H
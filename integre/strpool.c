@@ -0,0 +1,172 @@
+#include "strpool.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define POOL_ALIGN 4
+
+static Uint32 hashBytes(const char *text, size_t length) {
+    Uint32 h = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        h ^= (unsigned char)text[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static size_t entrySize(size_t length) {
+    return (sizeof(Uint32) + length + 1 + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1);
+}
+
+static int sameEntry(const StringPool *pool, Uint32 offset, const char *text, size_t length) {
+    Uint32 stored;
+    memcpy(&stored, pool->data + offset, sizeof(stored));
+    return stored == length && memcmp(pool->data + offset + sizeof(Uint32), text, length) == 0;
+}
+
+// Keeps the table at most half full.
+static int growSlots(StringPool *pool) {
+    Uint32 count = pool->slotCount ? pool->slotCount * 2 : 1024;
+    Uint32 *slots = calloc(count, sizeof(Uint32));
+    if (!slots)
+        return 0;
+    for (Uint32 i = 0; i < pool->slotCount; i++) {
+        Uint32 stored = pool->slots[i];
+        if (!stored)
+            continue;
+        Uint32 length;
+        memcpy(&length, pool->data + stored - 1, sizeof(length));
+        Uint32 j = hashBytes((const char *)pool->data + stored - 1 + sizeof(Uint32), length) & (count - 1);
+        while (slots[j])
+            j = (j + 1) & (count - 1);
+        slots[j] = stored;
+    }
+    free(pool->slots);
+    pool->slots = slots;
+    pool->slotCount = count;
+    return 1;
+}
+
+void initStringPool(StringPool *pool) {
+    memset(pool, 0, sizeof(*pool));
+}
+
+long internString(StringPool *pool, const char *text, size_t length) {
+    pool->requestedBytes += length;
+    if ((pool->entries + 1) * 2 > pool->slotCount && !growSlots(pool))
+        return -1;
+
+    Uint32 mask = pool->slotCount - 1;
+    Uint32 i = hashBytes(text, length) & mask;
+    for (; pool->slots[i]; i = (i + 1) & mask) {
+        if (sameEntry(pool, pool->slots[i] - 1, text, length))
+            return pool->slots[i] - 1;
+    }
+
+    size_t size = entrySize(length);
+    if (pool->size + size >= 0xFFFFFFFFu)
+        return -1;
+    if (pool->size + size > pool->capacity) {
+        size_t capacity = pool->capacity ? pool->capacity : 4096;
+        while (capacity < pool->size + size)
+            capacity *= 2;
+        Uint8 *grown = realloc(pool->data, capacity);
+        if (!grown)
+            return -1;
+        pool->data = grown;
+        pool->capacity = capacity;
+    }
+
+    Uint32 offset = (Uint32)pool->size;
+    Uint32 stored = (Uint32)length;
+    memset(pool->data + offset, 0, size);
+    memcpy(pool->data + offset, &stored, sizeof(stored));
+    memcpy(pool->data + offset + sizeof(Uint32), text, length);
+    pool->size += size;
+    pool->slots[i] = offset + 1;
+    pool->entries++;
+    return offset;
+}
+
+StringView poolString(const Uint8 *data, size_t size, Uint32 offset) {
+    StringView view = {"", 0};
+    Uint32 length;
+    if (offset % POOL_ALIGN || (size_t)offset + sizeof(Uint32) > size)
+        return view;
+    memcpy(&length, data + offset, sizeof(length));
+    const char *text = (const char *)data + offset + sizeof(Uint32);
+    if ((size_t)offset + sizeof(Uint32) + length + 1 > size || text[length] != '\0')
+        return view;
+    view.text = text;
+    view.length = length;
+    return view;
+}
+
+void freeStringPool(StringPool *pool) {
+    free(pool->data);
+    free(pool->slots);
+    memset(pool, 0, sizeof(*pool));
+}
+
+int isValidUtf8(const char *text, size_t length) {
+    const unsigned char *p = (const unsigned char *)text, *end = p + length;
+    while (p < end) {
+        int extra;
+        Uint32 cp;
+        if (*p < 0x80) {
+            p++;
+            continue;
+        } else if ((*p & 0xE0) == 0xC0) {
+            extra = 1;
+            cp = *p & 0x1F;
+        } else if ((*p & 0xF0) == 0xE0) {
+            extra = 2;
+            cp = *p & 0x0F;
+        } else if ((*p & 0xF8) == 0xF0) {
+            extra = 3;
+            cp = *p & 0x07;
+        } else {
+            return 0;
+        }
+        if (end - p <= extra)
+            return 0;
+        for (int i = 1; i <= extra; i++) {
+            if ((p[i] & 0xC0) != 0x80)
+                return 0;
+            cp = (cp << 6) | (p[i] & 0x3F);
+        }
+        // Overlong forms, surrogates and values past U+10FFFF
+        if ((extra == 1 && cp < 0x80) || (extra == 2 && cp < 0x800) || (extra == 3 && cp < 0x10000) ||
+            (cp >= 0xD800 && cp <= 0xDFFF) || cp > 0x10FFFF)
+            return 0;
+        p += extra + 1;
+    }
+    return 1;
+}
+
+int isAsciiView(StringView view) {
+    for (Uint32 i = 0; i < view.length; i++) {
+        if ((unsigned char)view.text[i] >= 0x80)
+            return 0;
+    }
+    return 1;
+}
+
+char* latin1ToUtf8(const char *text, size_t length, size_t *outLength) {
+    char *out = malloc(length * 2 + 1);
+    if (!out)
+        return NULL;
+    size_t n = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c < 0x80) {
+            out[n++] = (char)c;
+        } else {
+            out[n++] = (char)(0xC0 | (c >> 6));
+            out[n++] = (char)(0x80 | (c & 0x3F));
+        }
+    }
+    out[n] = '\0';
+    if (outLength)
+        *outLength = n;
+    return out;
+}
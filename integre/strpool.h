@@ -0,0 +1,43 @@
+#ifndef STRPOOL_H
+#define STRPOOL_H
+
+#include <SDL/SDL.h>
+#include <stddef.h>
+
+// Read-only view of a pooled string. `text` is also NUL-terminated, so it
+// can go straight to SDL_ttf; `length` is in bytes of UTF-8.
+typedef struct {
+    const char *text;
+    Uint32 length;
+} StringView;
+
+// Strings interned into one growing block: each distinct string is stored
+// once as a 32-bit length, the UTF-8 bytes and a NUL, padded to 4 bytes.
+// Entries are named by their offset, which stays valid as the block grows
+// (pointers do not), and the block can be written out as is.
+typedef struct {
+    Uint8 *data;
+    size_t size;
+    size_t capacity;
+    Uint32 *slots;             // Hash table of offset + 1, 0 when empty
+    Uint32 slotCount;
+    Uint32 entries;
+    size_t requestedBytes;     // Bytes asked for, duplicates included
+} StringPool;
+
+void initStringPool(StringPool *pool);
+// Returns the entry's offset, or -1 when out of memory or past 4 GB.
+long internString(StringPool *pool, const char *text, size_t length);
+// View of the entry at `offset` in a pool block (a StringPool's data or a
+// mapped copy of it). Bad offsets give an empty view instead of reading
+// out of bounds.
+StringView poolString(const Uint8 *data, size_t size, Uint32 offset);
+void freeStringPool(StringPool *pool);
+
+int isValidUtf8(const char *text, size_t length);
+int isAsciiView(StringView view);
+// Re-encodes Latin-1 text (older question files) as UTF-8. The result is
+// malloc'd.
+char* latin1ToUtf8(const char *text, size_t length, size_t *outLength);
+
+#endif // STRPOOL_H
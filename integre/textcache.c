@@ -0,0 +1,108 @@
+#include "textcache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static Uint32 hashText(const char *text) {
+    Uint32 h = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static int sameColor(SDL_Color a, SDL_Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+static void dropEntry(TextCache *cache, TextCacheEntry *e) {
+    cache->bytes -= e->bytes;
+    SDL_FreeSurface(e->surface);
+    free(e->text);
+    memset(e, 0, sizeof(*e));
+}
+
+static TextCacheEntry* evictLeastRecent(TextCache *cache) {
+    TextCacheEntry *oldest = NULL;
+    for (int i = 0; i < TEXT_CACHE_SLOTS; i++) {
+        TextCacheEntry *e = &cache->entries[i];
+        if (e->surface && (!oldest || e->lastUse < oldest->lastUse))
+            oldest = e;
+    }
+    if (oldest) {
+        dropEntry(cache, oldest);
+        cache->evictions++;
+    }
+    return oldest;
+}
+
+void initTextCache(TextCache *cache, size_t budget) {
+    memset(cache, 0, sizeof(*cache));
+    cache->budget = budget;
+}
+
+SDL_Surface* getCachedText(TextCache *cache, TTF_Font *font, SDL_Color color, const char *text) {
+    Uint32 hash = hashText(text);
+    TextCacheEntry *slot = NULL;
+
+    cache->clock++;
+    for (int i = 0; i < TEXT_CACHE_SLOTS; i++) {
+        TextCacheEntry *e = &cache->entries[i];
+        if (!e->surface) {
+            if (!slot) slot = e;
+            continue;
+        }
+        if (e->hash == hash && e->font == font && sameColor(e->color, color) &&
+            strcmp(e->text, text) == 0) {
+            e->lastUse = cache->clock;
+            cache->hits++;
+            return e->surface;
+        }
+    }
+
+    cache->misses++;
+    SDL_Surface *surface = TTF_RenderUTF8_Blended(font, text, color);
+    if (!surface)
+        return NULL;
+    size_t bytes = (size_t)surface->pitch * surface->h;
+
+    // Make room: free a slot if the table is full, then respect the byte budget.
+    if (!slot)
+        slot = evictLeastRecent(cache);
+    while (cache->bytes + bytes > cache->budget && cache->bytes > 0)
+        evictLeastRecent(cache);
+
+    slot->font = font;
+    slot->color = color;
+    slot->text = strdup(text);
+    slot->hash = hash;
+    slot->surface = surface;
+    slot->bytes = bytes;
+    slot->lastUse = cache->clock;
+    cache->bytes += bytes;
+    return surface;
+}
+
+void drawCachedText(SDL_Surface *screen, TextCache *cache, TTF_Font *font, SDL_Color color,
+                    const char *text, int x, int y) {
+    SDL_Surface *surface = getCachedText(cache, font, color, text);
+    if (surface) {
+        SDL_Rect pos = {x, y, 0, 0};
+        SDL_BlitSurface(surface, NULL, screen, &pos);
+    }
+}
+
+void printTextCacheStats(const TextCache *cache) {
+    unsigned long lookups = cache->hits + cache->misses;
+    printf("Text cache: %lu hits, %lu misses (%.1f%% hit rate), %lu evictions, %lu/%lu bytes\n",
+           cache->hits, cache->misses, lookups ? 100.0 * cache->hits / lookups : 0.0,
+           cache->evictions, (unsigned long)cache->bytes, (unsigned long)cache->budget);
+}
+
+void freeTextCache(TextCache *cache) {
+    for (int i = 0; i < TEXT_CACHE_SLOTS; i++) {
+        if (cache->entries[i].surface)
+            dropEntry(cache, &cache->entries[i]);
+    }
+}
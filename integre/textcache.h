@@ -0,0 +1,39 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_ttf.h>
+#include <stddef.h>
+
+#define TEXT_CACHE_SLOTS 32
+#define TEXT_CACHE_DEFAULT_BUDGET (1024 * 1024)
+
+typedef struct {
+    TTF_Font *font;
+    SDL_Color color;
+    char *text;
+    Uint32 hash;
+    SDL_Surface *surface;
+    size_t bytes;
+    Uint32 lastUse;        // Cache clock value at the last lookup, for LRU eviction
+} TextCacheEntry;
+
+typedef struct {
+    TextCacheEntry entries[TEXT_CACHE_SLOTS];
+    size_t bytes;          // Pixel bytes currently held
+    size_t budget;         // Upper bound for bytes
+    Uint32 clock;
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+} TextCache;
+
+void initTextCache(TextCache *cache, size_t budget);
+// The returned surface belongs to the cache and stays valid until the next lookup.
+SDL_Surface* getCachedText(TextCache *cache, TTF_Font *font, SDL_Color color, const char *text);
+void drawCachedText(SDL_Surface *screen, TextCache *cache, TTF_Font *font, SDL_Color color,
+                    const char *text, int x, int y);
+void printTextCacheStats(const TextCache *cache);
+void freeTextCache(TextCache *cache);
+
+#endif // TEXTCACHE_H
@@ -0,0 +1,187 @@
+#include "tilecache.h"
+#include "assets.h"
+#include "rawimage.h"
+#include "pak.h"
+#include <SDL/SDL_image.h>
+#include <SDL/SDL_rotozoom.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TILE_CACHE_MAGIC 0x434C4954  // "TILC"
+#define TILE_CACHE_VERSION 1
+
+static CachedTile *tiles = NULL;
+static int tileCount = 0;
+static int tileCapacity = 0;
+static int cacheDirty = 0;     // Entries added since the last load/save
+
+static CachedTile* findTile(const char *path, int tileSize) {
+    for (int i = 0; i < tileCount; i++) {
+        if (tiles[i].tileSize == tileSize && strcmp(tiles[i].path, path) == 0)
+            return &tiles[i];
+    }
+    return NULL;
+}
+
+static CachedTile* addTile(const char *path, int tileSize, long mtime, SDL_Surface *surface) {
+    if (tileCount == tileCapacity) {
+        int capacity = tileCapacity ? tileCapacity * 2 : 16;
+        CachedTile *grown = realloc(tiles, capacity * sizeof(CachedTile));
+        if (!grown)
+            return NULL;
+        tiles = grown;
+        tileCapacity = capacity;
+    }
+    CachedTile *t = &tiles[tileCount++];
+    t->path = strdup(path);
+    t->tileSize = tileSize;
+    t->mtime = mtime;
+    t->surface = surface;
+    return t;
+}
+
+SDL_Surface* getScaledTile(const char *path, int tileSize) {
+    CachedTile *t = findTile(path, tileSize);
+    if (t)
+        return t->surface;
+    long mtime = assetMtime(path);
+    if (mtime < 0)
+        return NULL;   // Missing file: the caller decides on a placeholder
+
+    SDL_Surface *original = IMG_Load_RW(openAssetRW(path), 1);
+    if (!original) {
+        printf("Error loading image: %s\n", path);
+        return NULL;
+    }
+    return adoptScaledTile(path, tileSize, original);
+}
+
+SDL_Surface* adoptScaledTile(const char *path, int tileSize, SDL_Surface *original) {
+    CachedTile *t = findTile(path, tileSize);
+    if (t || !original) {
+        SDL_FreeSurface(original);   // Cached meanwhile (e.g. by getScaledTile)
+        return t ? t->surface : NULL;
+    }
+    SDL_Surface *scaled = rotozoomSurface(original, 0, (double)tileSize / original->w, 1);
+    SDL_FreeSurface(original);
+    if (!scaled) {
+        printf("Error scaling image: %s\n", path);
+        return NULL;
+    }
+    scaled = optimizeOpaqueSurface(scaled);
+
+    if (!addTile(path, tileSize, assetMtime(path), scaled)) {
+        SDL_FreeSurface(scaled);
+        return NULL;
+    }
+    cacheDirty = 1;
+    return scaled;
+}
+
+int hasScaledTile(const char *path, int tileSize) {
+    return findTile(path, tileSize) != NULL;
+}
+
+SDL_Surface* storeScaledTile(const char *path, int tileSize, SDL_Surface *surface) {
+    if (!surface)
+        return NULL;
+    if (!addTile(path, tileSize, -1, surface)) {
+        SDL_FreeSurface(surface);
+        return NULL;
+    }
+    return surface;
+}
+
+int loadTileCache(const char *cacheFile) {
+    FILE *fp = fopen(cacheFile, "rb");
+    if (!fp)
+        return 0;
+
+    Uint32 header[3];
+    if (fread(header, sizeof(header), 1, fp) != 1 ||
+        header[0] != TILE_CACHE_MAGIC || header[1] != TILE_CACHE_VERSION) {
+        fclose(fp);
+        return 0;
+    }
+
+    int loaded = 0;
+    for (Uint32 i = 0; i < header[2]; i++) {
+        Uint32 pathLen;
+        Sint32 tileSize;
+        Sint64 mtime;
+        char path[256];
+        if (fread(&pathLen, sizeof(pathLen), 1, fp) != 1 || pathLen >= sizeof(path) ||
+            fread(path, 1, pathLen, fp) != pathLen ||
+            fread(&tileSize, sizeof(tileSize), 1, fp) != 1 ||
+            fread(&mtime, sizeof(mtime), 1, fp) != 1)
+            break;
+        path[pathLen] = '\0';
+
+        SDL_Surface *surface = readRawImage(fp);
+        if (!surface)
+            break;
+        if (findTile(path, tileSize) || assetMtime(path) != (long)mtime) {
+            SDL_FreeSurface(surface);   // Already cached, or the source changed
+            continue;
+        }
+        if (!addTile(path, tileSize, (long)mtime, optimizeOpaqueSurface(surface)))
+            break;
+        loaded++;
+    }
+    fclose(fp);
+    return loaded;
+}
+
+int saveTileCache(const char *cacheFile) {
+    if (!cacheDirty)
+        return 1;
+
+    FILE *fp = fopen(cacheFile, "wb");
+    if (!fp) {
+        printf("Warning: cannot write tile cache %s\n", cacheFile);
+        return 0;
+    }
+
+    Uint32 persisted = 0;
+    for (int i = 0; i < tileCount; i++) {
+        if (tiles[i].mtime >= 0)
+            persisted++;
+    }
+
+    Uint32 header[3] = {TILE_CACHE_MAGIC, TILE_CACHE_VERSION, persisted};
+    int ok = fwrite(header, sizeof(header), 1, fp) == 1;
+    for (int i = 0; i < tileCount && ok; i++) {
+        if (tiles[i].mtime < 0)
+            continue;
+        Uint32 pathLen = (Uint32)strlen(tiles[i].path);
+        Sint32 tileSize = tiles[i].tileSize;
+        Sint64 mtime = tiles[i].mtime;
+        ok = fwrite(&pathLen, sizeof(pathLen), 1, fp) == 1 &&
+             fwrite(tiles[i].path, 1, pathLen, fp) == pathLen &&
+             fwrite(&tileSize, sizeof(tileSize), 1, fp) == 1 &&
+             fwrite(&mtime, sizeof(mtime), 1, fp) == 1 &&
+             writeRawImage(fp, tiles[i].surface);
+    }
+    fclose(fp);
+
+    if (!ok) {
+        printf("Warning: failed to write tile cache %s\n", cacheFile);
+        remove(cacheFile);
+        return 0;
+    }
+    cacheDirty = 0;
+    return 1;
+}
+
+void freeTileCache(void) {
+    for (int i = 0; i < tileCount; i++) {
+        SDL_FreeSurface(tiles[i].surface);
+        free(tiles[i].path);
+    }
+    free(tiles);
+    tiles = NULL;
+    tileCount = 0;
+    tileCapacity = 0;
+    cacheDirty = 0;
+}
@@ -0,0 +1,32 @@
+#ifndef TILECACHE_H
+#define TILECACHE_H
+
+#include <SDL/SDL.h>
+
+#define TILE_CACHE_FILE "tiles.cache"
+
+typedef struct {
+    char *path;
+    int tileSize;
+    long mtime;            // Source file modification time when it was scaled
+    SDL_Surface *surface;  // Scaled, display-format tile
+} CachedTile;
+
+// Scaled tiles keyed by (path, tile size). They outlive MemoryGame
+// instances, so restarting a round costs no decoding or rotozoom.
+// The returned surface belongs to the cache: do not free it.
+SDL_Surface* getScaledTile(const char *path, int tileSize);
+// Scales and caches an image decoded elsewhere (e.g. on a preloader
+// thread); takes ownership of original.
+SDL_Surface* adoptScaledTile(const char *path, int tileSize, SDL_Surface *original);
+int hasScaledTile(const char *path, int tileSize);
+// Hands a generated tile (e.g. a placeholder for a missing file) to the
+// cache. Such tiles are kept in memory only.
+SDL_Surface* storeScaledTile(const char *path, int tileSize, SDL_Surface *surface);
+// Optional on-disk copy of the scaled pixels, so even a cold start
+// skips JPEG decoding. Entries whose source changed are ignored.
+int loadTileCache(const char *cacheFile);
+int saveTileCache(const char *cacheFile);
+void freeTileCache(void);
+
+#endif // TILECACHE_H
@@ -0,0 +1,85 @@
+// Bakes images to the display pixel format at their final size (baked.h),
+// so the game copies them at startup instead of decoding and stretching.
+//
+// Build (from integre/):
+//   gcc tools/bake_images.c baked.c pak.c -I. -o bake_images -lSDL -lSDL_image
+//   (add -DHAVE_LZ4 ... -llz4 to allow -z)
+// Run from integre/ so the manifest paths resolve:
+//   ./bake_images [-z] bake.list
+//
+// Manifest: "path" or "path WxH", like sprites.list. Each image is written
+// next to its source as path.bake; -z compresses it with LZ4.
+#include "baked.h"
+#include <SDL/SDL_image.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Same stretch as the preloader, so baked and decoded images are identical.
+static SDL_Surface* loadStretched(const char *path, int w, int h) {
+    SDL_Surface *original = IMG_Load(path);
+    if (!original) {
+        fprintf(stderr, "Erreur lors du chargement de %s : %s\n", path, IMG_GetError());
+        return NULL;
+    }
+    if (w <= 0 || h <= 0)
+        return original;
+    SDL_PixelFormat *fmt = original->format;
+    SDL_Surface *stretched = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, fmt->BitsPerPixel,
+                                                  fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask);
+    if (stretched && SDL_SoftStretch(original, NULL, stretched, NULL) < 0) {
+        SDL_FreeSurface(stretched);
+        stretched = NULL;
+    }
+    SDL_FreeSurface(original);
+    return stretched;
+}
+
+int main(int argc, char *argv[]) {
+    int compress = (argc == 3 && strcmp(argv[1], "-z") == 0);
+    if (argc != 2 + compress) {
+        fprintf(stderr, "Usage: %s [-z] manifest\n", argv[0]);
+        return 1;
+    }
+#ifndef HAVE_LZ4
+    if (compress)
+        fprintf(stderr, "Attention : compile sans LZ4, images non compressees\n");
+#endif
+    FILE *fp = fopen(argv[1 + compress], "r");
+    if (!fp) {
+        fprintf(stderr, "Erreur : impossible d'ouvrir %s\n", argv[1 + compress]);
+        return 1;
+    }
+
+    // The game's video mode decides the display format the images are baked to.
+    if (!getenv("SDL_VIDEODRIVER"))
+        putenv("SDL_VIDEODRIVER=dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0 || !SDL_SetVideoMode(800, 600, 32, SDL_SWSURFACE | SDL_SRCALPHA)) {
+        printf("SDL error: %s\n", SDL_GetError());
+        fclose(fp);
+        return 1;
+    }
+
+    int failed = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        char path[256];
+        int w = 0, h = 0;
+        if (line[0] == '#' || sscanf(line, "%255s %dx%d", path, &w, &h) < 1)
+            continue;
+        SDL_Surface *image = loadStretched(path, w, h);
+        SDL_Surface *converted = image ? SDL_DisplayFormat(image) : NULL;
+        if (!converted || !writeBakedImage(path, converted, compress)) {
+            failed++;
+        } else {
+            printf("%-16s %4dx%-4d baked\n", path, converted->w, converted->h);
+        }
+        if (converted)
+            SDL_FreeSurface(converted);
+        if (image)
+            SDL_FreeSurface(image);
+    }
+    fclose(fp);
+    SDL_Quit();
+    return failed ? 1 : 0;
+}
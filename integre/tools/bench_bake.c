@@ -0,0 +1,86 @@
+// Startup cost of the images in bake.list: decoding (and stretching) the
+// original as the game used to, versus loading the baked copy.
+//
+// Build (from integre/):
+//   gcc tools/bench_bake.c baked.c pak.c assets.c -I. -o bench_bake -lSDL -lSDL_image -lSDL_ttf -lSDL_mixer
+// Run from integre/ after tools/bake_images.c:
+//   ./bench_bake [iterations]
+// Both paths read from assets.pak when it is present, as the game does.
+#include "assets.h"
+#include "baked.h"
+#include "pak.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static SDL_Surface* decodeOriginal(const char *path, int w, int h) {
+    SDL_Surface *original = IMG_Load_RW(openAssetRW(path), 1);
+    if (!original || w <= 0 || h <= 0)
+        return optimizeOpaqueSurface(original);
+    SDL_PixelFormat *fmt = original->format;
+    SDL_Surface *stretched = SDL_CreateRGBSurface(SDL_SWSURFACE, w, h, fmt->BitsPerPixel,
+                                                  fmt->Rmask, fmt->Gmask, fmt->Bmask, fmt->Amask);
+    if (stretched)
+        SDL_SoftStretch(original, NULL, stretched, NULL);
+    SDL_FreeSurface(original);
+    return optimizeOpaqueSurface(stretched);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 20;
+    if (iterations <= 0)
+        iterations = 20;
+
+    if (!getenv("SDL_VIDEODRIVER"))
+        putenv("SDL_VIDEODRIVER=dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0 || !SDL_SetVideoMode(800, 600, 32, SDL_SWSURFACE | SDL_SRCALPHA)) {
+        printf("SDL error: %s\n", SDL_GetError());
+        return 1;
+    }
+    FILE *fp = fopen("bake.list", "r");
+    if (!fp) {
+        printf("bake.list not found: run from integre/\n");
+        SDL_Quit();
+        return 1;
+    }
+    if (openPak(PAK_FILE))
+        printf("Reading through %s\n", PAK_FILE);
+
+    double totalBefore = 0, totalAfter = 0;
+    printf("%-16s %9s %12s %12s %8s\n", "image", "size", "decode ms", "baked ms", "speedup");
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        char path[256];
+        int w = 0, h = 0;
+        if (line[0] == '#' || sscanf(line, "%255s %dx%d", path, &w, &h) < 1)
+            continue;
+
+        SDL_Surface *probe = loadBakedImage(path, w, h);
+        if (!probe) {
+            printf("%-16s (not baked)\n", path);
+            continue;
+        }
+        char size[16];
+        snprintf(size, sizeof(size), "%dx%d", probe->w, probe->h);
+        SDL_FreeSurface(probe);
+
+        Uint32 start = SDL_GetTicks();
+        for (int i = 0; i < iterations; i++)
+            SDL_FreeSurface(decodeOriginal(path, w, h));
+        double before = (double)(SDL_GetTicks() - start) / iterations;
+        start = SDL_GetTicks();
+        for (int i = 0; i < iterations; i++)
+            SDL_FreeSurface(loadBakedImage(path, w, h));
+        double after = (double)(SDL_GetTicks() - start) / iterations;
+
+        totalBefore += before;
+        totalAfter += after;
+        printf("%-16s %9s %12.2f %12.2f %7.1fx\n", path, size, before, after,
+               after > 0 ? before / after : 0.0);
+    }
+    fclose(fp);
+    printf("%-16s %9s %12.2f %12.2f\n", "total", "", totalBefore, totalAfter);
+
+    closePak();
+    SDL_Quit();
+    return 0;
+}
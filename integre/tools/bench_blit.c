@@ -0,0 +1,68 @@
+// Blit cost of the real assets as decoded versus after display-format conversion.
+//
+// Build (from integre/):
+//   gcc tools/bench_blit.c assets.c pak.c baked.c -I. -o bench_blit -lSDL -lSDL_image
+// Run from integre/ so the asset paths resolve:
+//   ./bench_blit [iterations]
+#include "assets.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *assetPaths[] = {
+    "bg.jpeg", "win.png", "lose.png", "timer_bar.png",
+    "quiz.png", "quizl.png", "puzzle.png", "puzzlel.png",
+    "reponse_a.png", "reponse_al.png", "images/1.jpg", "images/2.jpg",
+};
+
+static double blitMicros(SDL_Surface *src, SDL_Surface *screen, int iterations) {
+    Uint32 start = SDL_GetTicks();
+    for (int i = 0; i < iterations; i++) {
+        SDL_Rect pos = {0, 0, 0, 0};
+        SDL_BlitSurface(src, NULL, screen, &pos);
+    }
+    return (SDL_GetTicks() - start) * 1000.0 / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 500;
+    if (iterations <= 0)
+        iterations = 500;
+
+    if (!getenv("SDL_VIDEODRIVER"))
+        putenv("SDL_VIDEODRIVER=dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        printf("SDL_Init error: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface *screen = SDL_SetVideoMode(800, 600, 32, SDL_SWSURFACE);
+    if (!screen) {
+        printf("SDL_SetVideoMode error: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+
+    printf("%-16s %9s %12s %12s %8s\n", "asset", "size", "decoded us", "display us", "speedup");
+    for (size_t i = 0; i < sizeof(assetPaths) / sizeof(assetPaths[0]); i++) {
+        SDL_Surface *raw = IMG_Load(assetPaths[i]);
+        if (!raw) {
+            printf("%-16s (missing: %s)\n", assetPaths[i], IMG_GetError());
+            continue;
+        }
+        SDL_Surface *copy = SDL_ConvertSurface(raw, raw->format, raw->flags);
+        int isJpeg = (raw->format->Amask == 0);
+        SDL_Surface *fast = isJpeg ? optimizeOpaqueSurface(copy) : optimizeSurface(copy, 1);
+
+        double before = blitMicros(raw, screen, iterations);
+        double after = blitMicros(fast, screen, iterations);
+        char size[16];
+        snprintf(size, sizeof(size), "%dx%d", raw->w, raw->h);
+        printf("%-16s %9s %12.1f %12.1f %7.1fx\n", assetPaths[i], size, before, after,
+               after > 0 ? before / after : 0.0);
+
+        SDL_FreeSurface(raw);
+        SDL_FreeSurface(fast);
+    }
+
+    SDL_Quit();
+    return 0;
+}
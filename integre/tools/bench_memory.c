@@ -0,0 +1,101 @@
+// Render and click cost of the memory board for grid sizes 2 to 32.
+//
+// Build (from integre/):
+//   gcc tools/bench_memory.c enigme2.c assets.c tilecache.c rawimage.c textcache.c compositor.c
+//       hittest.c proctiles.c pak.c baked.c gradient.c -I. -o bench_memory -lSDL -lSDL_image -lSDL_ttf -lSDL_mixer -lSDL_gfx -lm
+// Run:
+//   ./bench_memory [iterations]
+// Boards above 4x4 use the large-board viewport: only the tiles inside it
+// are drawn, so render time should stay flat as the grid grows.
+#include "enigme2.h"
+#include "assets.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+Mix_Chunk *flipSound = NULL;
+Mix_Chunk *matchSound = NULL;
+Mix_Chunk *wrongSound = NULL;
+Mix_Chunk *winSound = NULL;
+Mix_Chunk *loseSound = NULL;
+TTF_Font *gFont = NULL;
+TextCache gTextCache;
+
+static const int gridSizes[] = {2, 4, 6, 8, 12, 16, 24, 32};
+
+static double renderMicros(MemoryGame *game, SDL_Surface *screen, int iterations) {
+    Uint32 start = SDL_GetTicks();
+    for (int i = 0; i < iterations; i++)
+        Memory_Render(game, screen);
+    return (SDL_GetTicks() - start) * 1000.0 / iterations;
+}
+
+// Clicks random points over the board; selections are reset after each
+// click so every event goes through the full path.
+static double clickMicros(MemoryGame *game, int iterations) {
+    const HitGrid *g = &game->hitGrid;
+    int width = g->cols * g->pitchX, height = g->rows * g->pitchY;
+    Uint32 start = SDL_GetTicks();
+    for (int i = 0; i < iterations; i++) {
+        SDL_Event ev = {0};
+        ev.type = SDL_MOUSEBUTTONDOWN;
+        ev.button.button = SDL_BUTTON_LEFT;
+        ev.button.x = g->originX + rand() % width;
+        ev.button.y = g->originY + rand() % height;
+        Memory_HandleEvent(game, &ev);
+        if (game->selected[0] != -1) {
+            int cell = game->selected[0];
+            game->flippedBits[cell >> 5] &= ~(1u << (cell & 31));
+            game->selected[0] = -1;
+        }
+    }
+    return (SDL_GetTicks() - start) * 1000.0 / iterations;
+}
+
+int main(int argc, char *argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 200;
+    if (iterations <= 0)
+        iterations = 200;
+
+    if (!getenv("SDL_VIDEODRIVER"))
+        putenv("SDL_VIDEODRIVER=dummy");
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        printf("SDL_Init error: %s\n", SDL_GetError());
+        return 1;
+    }
+    SDL_Surface *screen = SDL_SetVideoMode(SCREEN_W, SCREEN_H, 32, SDL_SWSURFACE);
+    if (!screen) {
+        printf("SDL_SetVideoMode error: %s\n", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    // Tile ids are compared, not surfaces, so one image can back every pair.
+    SDL_Surface *tile = optimizeOpaqueSurface(CreateDummySurfaceDynamic(TILE_SIZE));
+
+    printf("%-6s %8s %12s %12s %12s\n", "grid", "cells", "board bytes", "render us", "click us");
+    for (size_t s = 0; s < sizeof(gridSizes) / sizeof(gridSizes[0]); s++) {
+        MemoryGame game;
+        if (!Memory_InitBoard(&game, gridSizes[s], 1))
+            break;
+        for (int i = 0; i < game.total_pairs; i++)
+            game.images[i] = tile;
+        game.preview = 0;
+        // Half the tiles face up so both drawing paths are exercised.
+        for (int w = 0; w < MEMORY_BIT_WORDS(game.cells); w++)
+            game.flippedBits[w] = 0x55555555;
+
+        size_t boardBytes = game.total_pairs * sizeof(SDL_Surface *) +
+                            2 * MEMORY_BIT_WORDS(game.cells) * sizeof(Uint32) +
+                            game.cells * sizeof(Uint16);
+        double render = renderMicros(&game, screen, iterations);
+        double click = clickMicros(&game, iterations * 100);
+        char label[16];
+        snprintf(label, sizeof(label), "%dx%d", gridSizes[s], gridSizes[s]);
+        printf("%-6s %8d %12lu %12.1f %12.3f\n", label, game.cells, (unsigned long)boardBytes,
+               render, click);
+        Memory_Cleanup(&game);
+    }
+
+    SDL_FreeSurface(tile);
+    SDL_Quit();
+    return 0;
+}
@@ -0,0 +1,89 @@
+// Question sampling at bank sizes up to 1M: the incremental Fisher-Yates
+// sampler against the old approach of scanning every "used" flag per draw.
+//
+// Build (from integre/):
+//   gcc tools/bench_sampler.c sampler.c -I. -o bench_sampler -lSDL
+// Run:
+//   ./bench_sampler [items]
+#include "sampler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define GROUPS 8
+#define SCAN_DRAWS 1000
+
+static double secondsSince(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+// The previous getRandomQuestion(): collect the unused ids, pick one.
+static int scanDraw(unsigned char *used, Uint32 *indices, Uint32 count) {
+    Uint32 available = 0;
+    for (Uint32 i = 0; i < count; i++) {
+        if (!used[i]) indices[available++] = i;
+    }
+    if (available == 0) return -1;
+    int id = indices[rand() % available];
+    used[id] = 1;
+    return id;
+}
+
+int main(int argc, char *argv[]) {
+    Uint32 count = (argc > 1) ? (Uint32)atol(argv[1]) : 1000000;
+    if (count == 0)
+        count = 1000000;
+
+    Uint16 *keys = malloc(count * sizeof(Uint16));
+    unsigned char *seen = calloc(count, 1);
+    if (!keys || !seen)
+        return 1;
+    for (Uint32 i = 0; i < count; i++)
+        keys[i] = (Uint16)(i % GROUPS);
+
+    Sampler s;
+    clock_t start = clock();
+    if (!initSampler(&s, keys, count, 12345))
+        return 1;
+    printf("%u items, %d groups\n", count, GROUPS);
+    printf("init:            %8.2f ms\n", secondsSince(start) * 1000);
+
+    // Every item exactly once, then nothing.
+    start = clock();
+    int id, drawn = 0, repeats = 0;
+    while ((id = drawSample(&s)) >= 0) {
+        repeats += seen[id];
+        seen[id] = 1;
+        drawn++;
+    }
+    double all = secondsSince(start);
+    printf("draw all:        %8.2f ms (%.1f ns per draw, %u drawn, %d repeats)\n", all * 1000,
+           all * 1e9 / count, drawn, repeats);
+
+    start = clock();
+    for (int i = 0; i < 1000; i++)
+        resetSampler(&s);
+    printf("reset:           %8.2f us\n", secondsSince(start) * 1e6 / 1000);
+
+    // Group 0 weighted 3:1 over each other group.
+    setSamplerWeight(&s, 0, 3);
+    resetSampler(&s);
+    int first[GROUPS] = {0};
+    for (int i = 0; i < 100000 && (id = drawSample(&s)) >= 0; i++)
+        first[keys[id]]++;
+    printf("weighted 3:1:    group 0 %d, group 1 %d of 100000 draws\n", first[0], first[1]);
+
+    Uint32 *indices = malloc(count * sizeof(Uint32));
+    for (Uint32 i = 0; i < count; i++)
+        seen[i] = 0;
+    start = clock();
+    for (int i = 0; i < SCAN_DRAWS; i++)
+        scanDraw(seen, indices, count);
+    printf("used-flag scan:  %8.2f us per draw\n", secondsSince(start) * 1e6 / SCAN_DRAWS);
+
+    free(indices);
+    free(seen);
+    free(keys);
+    freeSampler(&s);
+    return 0;
+}
@@ -0,0 +1,34 @@
+// Compiles a question file (qbank.h text format) into a bank the game maps
+// and reads by id, however many questions it holds.
+//
+// Build (from integre/):
+//   gcc tools/compile_qbank.c qbank.c strpool.c pak.c -I. -o compile_qbank -lSDL
+// Run:
+//   ./compile_qbank sciencefiction_quiz.txt questions.qbank
+#include "qbank.h"
+#include <stdio.h>
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s questions.txt output.qbank\n", argv[0]);
+        return 1;
+    }
+    QuestionBank bank;
+    if (!compileQuestionText(&bank, argv[1])) {
+        fprintf(stderr, "Erreur : aucune question lue dans %s\n", argv[1]);
+        return 1;
+    }
+    int ok = writeQuestionBank(&bank, argv[2]);
+    if (ok) {
+        printf("%d questions in %u categories, %lu bytes\n", bank.count, bank.header->categoryCount,
+               (unsigned long)bank.size);
+        printf("Strings: %lu bytes of text in a %u byte pool\n", (unsigned long)bank.textBytes,
+               bank.header->poolSize);
+        for (Uint32 i = 0; i < bank.header->categoryCount; i++)
+            printf("  %s\n", getBankCategory(&bank, i));
+    } else {
+        fprintf(stderr, "Erreur : impossible d'ecrire %s\n", argv[2]);
+    }
+    closeQuestionBank(&bank);
+    return ok ? 0 : 1;
+}
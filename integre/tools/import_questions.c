@@ -0,0 +1,54 @@
+// Imports question files into one bank: parses them in parallel, rejects
+// malformed questions, drops repeats across files and prints what it kept.
+//
+// Build (from integre/):
+//   gcc tools/import_questions.c importer.c qbank.c strpool.c pak.c -I. -o import_questions -lSDL
+// Run:
+//   ./import_questions [-j threads] [-o questions.qbank] files...
+// Exits with 2 when the bank was written but some questions were rejected.
+#include "importer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+int main(int argc, char *argv[]) {
+    const char *output = QBANK_FILE;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int first = 1;
+    while (first + 1 < argc && argv[first][0] == '-') {
+        if (strcmp(argv[first], "-j") == 0)
+            threads = atoi(argv[first + 1]);
+        else if (strcmp(argv[first], "-o") == 0)
+            output = argv[first + 1];
+        else
+            break;
+        first += 2;
+    }
+    if (first >= argc || argv[first][0] == '-') {
+        fprintf(stderr, "Usage: %s [-j threads] [-o questions.qbank] files...\n", argv[0]);
+        return 1;
+    }
+
+    SDL_Init(0);   // Starts the tick counter used for the timings
+    QuestionBank bank;
+    ImportReport report;
+    int ok = importQuestionFiles((const char *const *)argv + first, argc - first, threads, &bank, &report);
+    printImportReport(&report, stdout);
+    if (ok) {
+        ok = writeQuestionBank(&bank, output);
+        if (ok)
+            printf("%d questions written to %s (%lu bytes)\n", bank.count, output, (unsigned long)bank.size);
+        else
+            fprintf(stderr, "Erreur : impossible d'ecrire %s\n", output);
+        closeQuestionBank(&bank);
+    } else {
+        fprintf(stderr, "Erreur : aucune question importee\n");
+    }
+    int clean = report.errors == 0;
+    freeImportReport(&report);
+    SDL_Quit();
+    if (!ok)
+        return 1;
+    return clean ? 0 : 2;
+}
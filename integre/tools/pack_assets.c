@@ -0,0 +1,130 @@
+// Packs the game files named in a manifest into one archive (pak.h).
+//
+// Build (from integre/):
+//   gcc tools/pack_assets.c -I. -o pack_assets
+// Run from integre/ so the manifest paths resolve:
+//   ./pack_assets assets.list assets.pak
+//
+// Manifest: one relative path per line. Blank lines and lines starting
+// with # are skipped; missing files are reported and left to the disk.
+#include "pak.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define MAX_PAK_FILES 256
+
+typedef struct {
+    PakEntry entry;
+    char path[256];
+} PackedFile;
+
+static PackedFile files[MAX_PAK_FILES];
+static int fileCount = 0;
+
+static int byName(const void *a, const void *b) {
+    return strncmp(((const PackedFile *)a)->entry.name, ((const PackedFile *)b)->entry.name,
+                   PAK_NAME_LENGTH);
+}
+
+static int readManifest(const char *manifest) {
+    FILE *fp = fopen(manifest, "r");
+    if (!fp) {
+        fprintf(stderr, "Erreur : impossible d'ouvrir %s\n", manifest);
+        return 0;
+    }
+    char line[512];
+    while (fgets(line, sizeof(line), fp)) {
+        char path[256];
+        if (line[0] == '#' || sscanf(line, "%255s", path) != 1)
+            continue;
+        const char *name = path;
+        while (name[0] == '.' && name[1] == '/')
+            name += 2;
+        struct stat st;
+        if (stat(path, &st) != 0) {
+            fprintf(stderr, "Attention : %s introuvable, ignore\n", path);
+            continue;
+        }
+        if (strlen(name) >= PAK_NAME_LENGTH || fileCount == MAX_PAK_FILES || st.st_size > 0x7FFFFFFF) {
+            fprintf(stderr, "Erreur : impossible d'ajouter %s\n", path);
+            fclose(fp);
+            return 0;
+        }
+        PackedFile *f = &files[fileCount++];
+        memset(f, 0, sizeof(*f));
+        strcpy(f->path, path);
+        strcpy(f->entry.name, name);
+        f->entry.size = (Uint32)st.st_size;
+        f->entry.mtime = (Sint64)st.st_mtime;
+    }
+    fclose(fp);
+
+    // The game looks files up with a binary search.
+    qsort(files, fileCount, sizeof(PackedFile), byName);
+    for (int i = 1; i < fileCount; i++) {
+        if (strcmp(files[i - 1].entry.name, files[i].entry.name) == 0) {
+            fprintf(stderr, "Erreur : %s liste deux fois\n", files[i].entry.name);
+            return 0;
+        }
+    }
+    return fileCount > 0;
+}
+
+static int copyFile(FILE *out, const PackedFile *f) {
+    FILE *in = fopen(f->path, "rb");
+    if (!in)
+        return 0;
+    char buffer[65536];
+    Uint32 copied = 0;
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0 && copied + n <= f->entry.size) {
+        if (fwrite(buffer, 1, n, out) != n)
+            break;
+        copied += n;
+    }
+    fclose(in);
+    return copied == f->entry.size;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s manifest output.pak\n", argv[0]);
+        return 1;
+    }
+    if (!readManifest(argv[1]))
+        return 1;
+
+    Uint32 offset = sizeof(PakHeader) + fileCount * sizeof(PakEntry);
+    for (int i = 0; i < fileCount; i++) {
+        offset = (offset + PAK_ALIGN - 1) & ~(Uint32)(PAK_ALIGN - 1);
+        files[i].entry.offset = offset;
+        offset += files[i].entry.size;
+    }
+
+    FILE *fp = fopen(argv[2], "wb");
+    if (!fp) {
+        fprintf(stderr, "Erreur : impossible d'ecrire %s\n", argv[2]);
+        return 1;
+    }
+    PakHeader hdr = {PAK_MAGIC, PAK_VERSION, fileCount};
+    int ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+    for (int i = 0; i < fileCount && ok; i++)
+        ok = fwrite(&files[i].entry, sizeof(PakEntry), 1, fp) == 1;
+    for (int i = 0; i < fileCount && ok; i++) {
+        static const char zeros[PAK_ALIGN];
+        long pad = files[i].entry.offset - ftell(fp);
+        ok = pad >= 0 && (pad == 0 || fwrite(zeros, 1, pad, fp) == (size_t)pad) && copyFile(fp, &files[i]);
+        if (!ok)
+            fprintf(stderr, "Erreur lors de la copie de %s\n", files[i].path);
+    }
+    if (fclose(fp) != 0)
+        ok = 0;
+    if (!ok) {
+        remove(argv[2]);
+        return 1;
+    }
+    printf("%d files packed into %s (%u bytes)\n", fileCount, argv[2], offset);
+    return 0;
+}
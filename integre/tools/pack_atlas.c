@@ -0,0 +1,188 @@
+// Packs the images named in a manifest into one sprite atlas file.
+//
+// Build (from integre/):
+//   gcc tools/pack_atlas.c rawimage.c -I. -o pack_atlas -lSDL -lSDL_image -lSDL_gfx
+// Run from the directory the manifest paths are relative to:
+//   ./pack_atlas sprites.list sprites.atlas
+//
+// Manifest: one image per line, "path" or "path WxH" to scale it first
+// (memory tiles). Blank lines and lines starting with # are skipped.
+#include "spriteatlas.h"
+#include "rawimage.h"
+#include <SDL/SDL_image.h>
+#include <SDL/SDL_rotozoom.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PACK_WIDTH 1024   // Minimum; widened to fit the widest image
+#define PACK_PADDING 1
+#define MAX_PACKED 256
+
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+#define PACK_RMASK 0xFF000000
+#define PACK_GMASK 0x00FF0000
+#define PACK_BMASK 0x0000FF00
+#define PACK_AMASK 0x000000FF
+#else
+#define PACK_RMASK 0x000000FF
+#define PACK_GMASK 0x0000FF00
+#define PACK_BMASK 0x00FF0000
+#define PACK_AMASK 0xFF000000
+#endif
+
+typedef struct {
+    AtlasFileEntry entry;
+    SDL_Surface *pixels;   // 32-bit RGBA
+} PackedImage;
+
+static PackedImage images[MAX_PACKED];
+static int imageCount = 0;
+static int packWidth = PACK_WIDTH;
+
+// Decodes, optionally scales, and converts to RGBA keeping the alpha as is.
+static SDL_Surface* loadRgba(const char *path, int w, int h) {
+    SDL_Surface *src = IMG_Load(path);
+    if (!src) {
+        fprintf(stderr, "Erreur lors du chargement de %s : %s\n", path, IMG_GetError());
+        return NULL;
+    }
+    if (w > 0 && h > 0 && (src->w != w || src->h != h)) {
+        SDL_Surface *scaled = zoomSurface(src, (double)w / src->w, (double)h / src->h, 1);
+        SDL_FreeSurface(src);
+        if (!scaled)
+            return NULL;
+        src = scaled;
+    }
+    SDL_Surface *rgba = SDL_CreateRGBSurface(SDL_SWSURFACE, src->w, src->h, 32,
+                                             PACK_RMASK, PACK_GMASK, PACK_BMASK, PACK_AMASK);
+    if (rgba) {
+        if (!src->format->Amask)
+            SDL_FillRect(rgba, NULL, SDL_MapRGBA(rgba->format, 0, 0, 0, 255));
+        SDL_SetAlpha(src, 0, SDL_ALPHA_OPAQUE);   // Copy the alpha channel instead of blending
+        SDL_BlitSurface(src, NULL, rgba, NULL);
+    }
+    SDL_FreeSurface(src);
+    return rgba;
+}
+
+static int isOpaque(SDL_Surface *s) {
+    SDL_LockSurface(s);
+    for (int y = 0; y < s->h; y++) {
+        const Uint32 *row = (const Uint32 *)((const Uint8 *)s->pixels + y * s->pitch);
+        for (int x = 0; x < s->w; x++) {
+            if ((row[x] & PACK_AMASK) != PACK_AMASK) {
+                SDL_UnlockSurface(s);
+                return 0;
+            }
+        }
+    }
+    SDL_UnlockSurface(s);
+    return 1;
+}
+
+static int readManifest(const char *manifest) {
+    FILE *fp = fopen(manifest, "r");
+    if (!fp) {
+        fprintf(stderr, "Erreur : impossible d'ouvrir %s\n", manifest);
+        return 0;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), fp)) {
+        char path[ATLAS_NAME_LENGTH];
+        int w = 0, h = 0;
+        if (line[0] == '#' || sscanf(line, "%63s %dx%d", path, &w, &h) < 1)
+            continue;
+        if (imageCount == MAX_PACKED) {
+            fprintf(stderr, "Erreur : plus de %d images\n", MAX_PACKED);
+            break;
+        }
+        SDL_Surface *pixels = loadRgba(path, w, h);
+        if (!pixels)
+            continue;
+        PackedImage *img = &images[imageCount++];
+        memset(img, 0, sizeof(*img));
+        strncpy(img->entry.name, path, ATLAS_NAME_LENGTH - 1);
+        img->entry.w = pixels->w;
+        img->entry.h = pixels->h;
+        img->entry.tileSize = (w > 0 && w == h) ? w : 0;
+        img->entry.opaque = isOpaque(pixels);
+        img->pixels = pixels;
+    }
+    fclose(fp);
+    return imageCount > 0;
+}
+
+static int byHeight(const void *a, const void *b) {
+    return ((const PackedImage *)b)->entry.h - ((const PackedImage *)a)->entry.h;
+}
+
+// Shelf packing, tallest first: each row is as tall as its first image.
+static int packShelves(void) {
+    int x = 0, y = 0, rowHeight = 0;
+    qsort(images, imageCount, sizeof(PackedImage), byHeight);
+    for (int i = 0; i < imageCount; i++) {
+        if (images[i].entry.w > packWidth)
+            packWidth = images[i].entry.w;
+    }
+    for (int i = 0; i < imageCount; i++) {
+        AtlasFileEntry *e = &images[i].entry;
+        if (x + e->w > packWidth) {
+            x = 0;
+            y += rowHeight + PACK_PADDING;
+            rowHeight = 0;
+        }
+        e->x = x;
+        e->y = y;
+        x += e->w + PACK_PADDING;
+        if (e->h > rowHeight)
+            rowHeight = e->h;
+    }
+    return y + rowHeight;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s manifest output.atlas\n", argv[0]);
+        return 1;
+    }
+    if (SDL_Init(0) < 0 || !readManifest(argv[1]))
+        return 1;
+
+    int height = packShelves();
+    if (height <= 0)
+        return 1;
+    SDL_Surface *atlas = SDL_CreateRGBSurface(SDL_SWSURFACE, packWidth, height, 32,
+                                              PACK_RMASK, PACK_GMASK, PACK_BMASK, PACK_AMASK);
+    if (!atlas)
+        return 1;
+    SDL_FillRect(atlas, NULL, 0);
+    for (int i = 0; i < imageCount; i++) {
+        SDL_Rect dst = {images[i].entry.x, images[i].entry.y, 0, 0};
+        SDL_BlitSurface(images[i].pixels, NULL, atlas, &dst);
+    }
+
+    FILE *fp = fopen(argv[2], "wb");
+    if (!fp) {
+        fprintf(stderr, "Erreur : impossible d'ecrire %s\n", argv[2]);
+        return 1;
+    }
+    AtlasFileHeader hdr = {SPRITE_ATLAS_MAGIC, SPRITE_ATLAS_VERSION, imageCount};
+    int ok = fwrite(&hdr, sizeof(hdr), 1, fp) == 1;
+    for (int i = 0; i < imageCount && ok; i++)
+        ok = fwrite(&images[i].entry, sizeof(AtlasFileEntry), 1, fp) == 1;
+    ok = ok && writeRawImage(fp, atlas);
+    if (fclose(fp) != 0)
+        ok = 0;
+
+    long used = 0;
+    for (int i = 0; i < imageCount; i++) {
+        used += (long)images[i].entry.w * images[i].entry.h;
+        SDL_FreeSurface(images[i].pixels);
+    }
+    printf("%d images packed into %dx%d (%.0f%% used)\n", imageCount, packWidth, height,
+           100.0 * used / ((long)packWidth * height));
+    SDL_FreeSurface(atlas);
+    SDL_Quit();
+    return ok ? 0 : 1;
+}